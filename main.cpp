@@ -18,12 +18,14 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <memory>
+#include <stdexcept>
+
 #include <getopt.h>
 #include <unistd.h>
 
 #include <libsigrokcxx/libsigrokcxx.hpp>
 
-#include <QDateTime>
 #include <QDebug>
 #include <QSettings>
 
@@ -31,7 +33,9 @@
 #include "src/application.hpp"
 #include "src/devicemanager.hpp"
 #include "src/session.hpp"
+#include "src/sessionclock.hpp"
 #include "src/mainwindow.hpp"
+#include "src/devices/acquisitionexecutor.hpp"
 
 #ifdef ENABLE_SIGNALS
 #include "signalhandler.hpp"
@@ -44,6 +48,7 @@ Q_IMPORT_PLUGIN(QSvgPlugin)
 #endif
 
 using std::exception;
+using std::make_shared;
 using std::shared_ptr;
 using std::string;
 using std::vector;
@@ -63,6 +68,10 @@ void usage()
 		"  -d, --driver               Specify the device driver(s) to use\n"
 		"  -D, --dont-scan            Don't auto-scan for devices, use -d spec only\n"
 		"  -s, --script               Specify the SmuScript to load and execute\n"
+		"  -w, --acquisition-workers  Run the device sessions on a shared pool of\n"
+		"                             worker threads (0: one thread per device)\n"
+		"  -g, --load-generator       Add a synthetic load generator device, e.g.\n"
+		"                             channels=4:samplerate=1M:packetsize=1000:waveform=sine\n"
 		/* Disable cmd line options i, I and c
 		"  -i, --input-file           Load input from file\n"
 		"  -I, --input-format         Input format\n"
@@ -90,6 +99,8 @@ int main(int argc, char *argv[])
 	bool restore_session = true;
 	bool do_scan = true;
 	string script_file;
+	int acquisition_workers = 0;
+	string load_generator_spec;
 
 	Application app(argc, argv);
 
@@ -102,6 +113,8 @@ int main(int argc, char *argv[])
 			{ "driver", required_argument, nullptr, 'd' },
 			{ "dont-scan", no_argument, nullptr, 'D' },
 			{ "script", required_argument, nullptr, 's' },
+			{ "acquisition-workers", required_argument, nullptr, 'w' },
+			{ "load-generator", required_argument, nullptr, 'g' },
 			/* Disable cmd line options i, I and c
 			{ "input-file", required_argument, nullptr, 'i' },
 			{ "input-format", required_argument, nullptr, 'I' },
@@ -115,7 +128,7 @@ int main(int argc, char *argv[])
 			"l:Vhc?d:i:I:", long_options, nullptr);
 		*/
 		const int c = getopt_long(argc, argv,
-			"h?VDl:d:s:", long_options, nullptr);
+			"h?VDl:d:s:w:g:", long_options, nullptr);
 
 		if (c == -1)
 			break;
@@ -156,6 +169,14 @@ int main(int argc, char *argv[])
 			script_file = optarg;
 			break;
 
+		case 'w':
+			acquisition_workers = atoi(optarg);
+			break;
+
+		case 'g':
+			load_generator_spec = optarg;
+			break;
+
 		/* Disable cmd line options i, I and c
 		case 'i':
 			open_file = optarg;
@@ -184,12 +205,18 @@ int main(int argc, char *argv[])
 	context = sigrok::Context::create();
 	sv::Session::sr_context = context;
 
+	if (acquisition_workers > 0) {
+		sv::Session::acquisition_executor =
+			make_shared<sv::devices::AcquisitionExecutor>(
+				(size_t)acquisition_workers);
+	}
+
 	do {
 		try {
 			// Initialize global start timestamp
-			// TODO: use std::chrono / std::time
+			sv::SessionClock::init();
 			sv::Session::session_start_timestamp =
-				QDateTime::currentMSecsSinceEpoch() / (double)1000;
+				sv::SessionClock::start_timestamp();
 
 			// Create the device manager, initialise the drivers
 			sv::DeviceManager device_manager(context, drivers, do_scan);
@@ -208,6 +235,17 @@ int main(int argc, char *argv[])
 			else
 				w.init_default_session();
 
+			if (!load_generator_spec.empty()) {
+				try {
+					auto device = w.session()->
+						add_load_generator_device_from_spec(load_generator_spec);
+					w.add_device_tab(device);
+				}
+				catch (const std::runtime_error &e) {
+					qCritical() << e.what();
+				}
+			}
+
 			if (!script_file.empty())
 				w.run_smu_script(script_file); // TODO: Call in Session not MainWindow
 
@@ -237,5 +275,8 @@ int main(int argc, char *argv[])
 	}
 	while (false);
 
+	// The devices have been closed, stop the acquisition workers.
+	sv::Session::acquisition_executor.reset();
+
 	return ret;
 }
@@ -0,0 +1,173 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2020 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cassert>
+#include <limits>
+#include <memory>
+#include <set>
+#include <string>
+
+#include <QDebug>
+
+#include "decimatechannel.hpp"
+#include "src/channels/basechannel.hpp"
+#include "src/channels/mathchannel.hpp"
+#include "src/data/analogtimesignal.hpp"
+#include "src/data/datautil.hpp"
+#include "src/devices/basedevice.hpp"
+
+using std::set;
+using std::string;
+
+namespace sv {
+namespace channels {
+
+DecimateChannel::DecimateChannel(
+		data::Quantity quantity,
+		set<data::QuantityFlag> quantity_flags,
+		data::Unit unit,
+		shared_ptr<data::AnalogTimeSignal> signal,
+		size_t factor,
+		DecimationMode mode,
+		shared_ptr<devices::BaseDevice> parent_device,
+		set<string> channel_group_names,
+		string channel_name,
+		double channel_start_timestamp) :
+	MathChannel(quantity, quantity_flags, unit,
+		parent_device, channel_group_names, channel_name,
+		channel_start_timestamp),
+	signal_(signal),
+	factor_(factor),
+	mode_(mode),
+	next_signal_pos_(0)
+{
+	assert(signal_);
+	assert(factor_ > 0);
+
+	digits_ = signal_->digits();
+	decimal_places_ = signal_->decimal_places();
+
+	reset_block();
+
+	connect(signal_.get(), SIGNAL(sample_appended()),
+		this, SLOT(on_sample_appended()));
+	connect(signal_.get(), SIGNAL(samples_cleared()),
+		this, SLOT(on_samples_cleared()));
+}
+
+size_t DecimateChannel::factor() const
+{
+	return factor_;
+}
+
+DecimationMode DecimateChannel::mode() const
+{
+	return mode_;
+}
+
+void DecimateChannel::reset_block()
+{
+	block_count_ = 0;
+	block_sum_ = 0.;
+	block_first_timestamp_ = 0.;
+	block_last_timestamp_ = 0.;
+	block_last_value_ = 0.;
+	block_min_ = std::numeric_limits<double>::max();
+	block_min_timestamp_ = 0.;
+	block_max_ = std::numeric_limits<double>::lowest();
+	block_max_timestamp_ = 0.;
+}
+
+void DecimateChannel::finish_block()
+{
+	switch (mode_) {
+	case DecimationMode::Mean:
+		// Use the center of the block as timestamp
+		batch_samples_.push_back(block_sum_ / (double)block_count_);
+		batch_timestamps_.push_back(
+			(block_first_timestamp_ + block_last_timestamp_) / 2.);
+		break;
+	case DecimationMode::MinMax:
+		// Keep the chronological order of the extrema
+		if (block_min_timestamp_ <= block_max_timestamp_) {
+			batch_samples_.push_back(block_min_);
+			batch_timestamps_.push_back(block_min_timestamp_);
+			if (block_max_timestamp_ != block_min_timestamp_) {
+				batch_samples_.push_back(block_max_);
+				batch_timestamps_.push_back(block_max_timestamp_);
+			}
+		}
+		else {
+			batch_samples_.push_back(block_max_);
+			batch_timestamps_.push_back(block_max_timestamp_);
+			batch_samples_.push_back(block_min_);
+			batch_timestamps_.push_back(block_min_timestamp_);
+		}
+		break;
+	case DecimationMode::Last:
+	default:
+		batch_samples_.push_back(block_last_value_);
+		batch_timestamps_.push_back(block_last_timestamp_);
+		break;
+	}
+
+	reset_block();
+}
+
+void DecimateChannel::on_sample_appended()
+{
+	batch_samples_.clear();
+	batch_timestamps_.clear();
+
+	size_t signal_sample_count = signal_->sample_count();
+	while (next_signal_pos_ < signal_sample_count) {
+		auto sample = signal_->get_sample(next_signal_pos_, false);
+		if (block_count_ == 0)
+			block_first_timestamp_ = sample.first;
+		block_last_timestamp_ = sample.first;
+		block_last_value_ = sample.second;
+		block_sum_ += sample.second;
+		if (sample.second < block_min_) {
+			block_min_ = sample.second;
+			block_min_timestamp_ = sample.first;
+		}
+		if (sample.second > block_max_) {
+			block_max_ = sample.second;
+			block_max_timestamp_ = sample.first;
+		}
+		++block_count_;
+		++next_signal_pos_;
+
+		if (block_count_ == factor_)
+			finish_block();
+	}
+
+	if (!batch_samples_.empty())
+		push_samples(batch_samples_, batch_timestamps_);
+}
+
+void DecimateChannel::on_samples_cleared()
+{
+	// The source signal starts again at position 0. The samples of the
+	// actual (incomplete) block are kept.
+	next_signal_pos_ = 0;
+}
+
+} // namespace channels
+} // namespace sv
@@ -0,0 +1,131 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2020 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CHANNELS_DECIMATECHANNEL_HPP
+#define CHANNELS_DECIMATECHANNEL_HPP
+
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <QObject>
+
+#include "src/channels/basechannel.hpp"
+#include "src/channels/mathchannel.hpp"
+#include "src/data/datautil.hpp"
+
+using std::set;
+using std::shared_ptr;
+using std::string;
+using std::vector;
+
+namespace sv {
+
+namespace data {
+class AnalogTimeSignal;
+}
+
+namespace devices {
+class BaseDevice;
+}
+
+namespace channels {
+
+enum class DecimationMode {
+	/**
+	 * Mean value of the block (box-car average)
+	 */
+	Mean,
+	/**
+	 * Minimum and maximum value of the block (two samples per block)
+	 */
+	MinMax,
+	/**
+	 * Last value of the block
+	 */
+	Last
+};
+
+/**
+ * Reduces every block of factor samples of a signal to one output sample
+ * (two for DecimationMode::MinMax).
+ *
+ * Every sample of the source signal is only read once, so the decimated
+ * signal keeps its history even when the source signal is cleared.
+ */
+class DecimateChannel : public MathChannel
+{
+	Q_OBJECT
+
+public:
+	DecimateChannel(
+		data::Quantity quantity,
+		set<data::QuantityFlag> quantity_flags,
+		data::Unit unit,
+		shared_ptr<data::AnalogTimeSignal> signal,
+		size_t factor,
+		DecimationMode mode,
+		shared_ptr<devices::BaseDevice> parent_device,
+		set<string> channel_group_names,
+		string channel_name,
+		double channel_start_timestamp);
+
+	/**
+	 * Return the number of source samples per block.
+	 */
+	size_t factor() const;
+
+	/**
+	 * Return the decimation mode.
+	 */
+	DecimationMode mode() const;
+
+private:
+	void reset_block();
+	void finish_block();
+
+	shared_ptr<data::AnalogTimeSignal> signal_;
+	size_t factor_;
+	DecimationMode mode_;
+	size_t next_signal_pos_;
+
+	size_t block_count_;
+	double block_sum_;
+	double block_first_timestamp_;
+	double block_last_timestamp_;
+	double block_last_value_;
+	double block_min_;
+	double block_min_timestamp_;
+	double block_max_;
+	double block_max_timestamp_;
+
+	vector<double> batch_samples_;
+	vector<double> batch_timestamps_;
+
+private Q_SLOTS:
+	void on_sample_appended();
+	void on_samples_cleared();
+
+};
+
+} // namespace channels
+} // namespace sv
+
+#endif // CHANNELS_DECIMATECHANNEL_HPP
@@ -0,0 +1,245 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2020 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <cassert>
+#include <memory>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <QDebug>
+
+#include "eventdetectorchannel.hpp"
+#include "src/channels/basechannel.hpp"
+#include "src/channels/mathchannel.hpp"
+#include "src/data/analogtimesignal.hpp"
+#include "src/data/datautil.hpp"
+#include "src/devices/basedevice.hpp"
+
+using std::make_pair;
+using std::pair;
+using std::set;
+using std::string;
+using std::vector;
+
+namespace sv {
+namespace channels {
+
+EventDetectorChannel::EventDetectorChannel(
+		data::Quantity quantity,
+		set<data::QuantityFlag> quantity_flags,
+		data::Unit unit,
+		shared_ptr<data::AnalogTimeSignal> signal,
+		double level,
+		double hysteresis,
+		EventEdge edge,
+		shared_ptr<devices::BaseDevice> parent_device,
+		set<string> channel_group_names,
+		string channel_name,
+		double channel_start_timestamp) :
+	MathChannel(quantity, quantity_flags, unit,
+		parent_device, channel_group_names, channel_name,
+		channel_start_timestamp),
+	signal_(signal),
+	level_(level),
+	hysteresis_(hysteresis),
+	edge_(edge),
+	next_signal_pos_(0),
+	state_(State::Unknown),
+	last_timestamp_(0.),
+	last_value_(0.),
+	rising_crossing_timestamp_(0.),
+	falling_crossing_timestamp_(0.)
+{
+	assert(signal_);
+	assert(hysteresis_ >= 0);
+
+	digits_ = signal_->digits();
+	decimal_places_ = signal_->decimal_places();
+
+	connect(signal_.get(), SIGNAL(sample_appended()),
+		this, SLOT(on_sample_appended()));
+	connect(signal_.get(), SIGNAL(samples_cleared()),
+		this, SLOT(on_samples_cleared()));
+}
+
+double EventDetectorChannel::level() const
+{
+	return level_;
+}
+
+double EventDetectorChannel::hysteresis() const
+{
+	return hysteresis_;
+}
+
+EventEdge EventDetectorChannel::edge() const
+{
+	return edge_;
+}
+
+size_t EventDetectorChannel::event_count() const
+{
+	return event_timestamps_.size();
+}
+
+pair<double, bool> EventDetectorChannel::get_event(
+	size_t pos, bool relative_time) const
+{
+	assert(pos < event_timestamps_.size());
+
+	double timestamp = event_timestamps_[pos];
+	if (relative_time)
+		timestamp -= signal_->signal_start_timestamp();
+	return make_pair(timestamp, event_rising_[pos]);
+}
+
+int64_t EventDetectorChannel::next_event(
+	double timestamp, bool relative_time) const
+{
+	if (relative_time)
+		timestamp += signal_->signal_start_timestamp();
+
+	auto it = std::upper_bound(
+		event_timestamps_.begin(), event_timestamps_.end(), timestamp);
+	if (it == event_timestamps_.end())
+		return -1;
+	return it - event_timestamps_.begin();
+}
+
+int64_t EventDetectorChannel::previous_event(
+	double timestamp, bool relative_time) const
+{
+	if (relative_time)
+		timestamp += signal_->signal_start_timestamp();
+
+	auto it = std::lower_bound(
+		event_timestamps_.begin(), event_timestamps_.end(), timestamp);
+	if (it == event_timestamps_.begin())
+		return -1;
+	return (it - event_timestamps_.begin()) - 1;
+}
+
+vector<double> EventDetectorChannel::events_between(double start_timestamp,
+	double end_timestamp, bool relative_time) const
+{
+	double offset = 0.;
+	if (relative_time)
+		offset = signal_->signal_start_timestamp();
+
+	auto first = std::lower_bound(event_timestamps_.begin(),
+		event_timestamps_.end(), start_timestamp + offset);
+	auto last = std::upper_bound(first,
+		event_timestamps_.end(), end_timestamp + offset);
+
+	vector<double> timestamps(first, last);
+	if (relative_time) {
+		for (auto &ts : timestamps)
+			ts -= offset;
+	}
+	return timestamps;
+}
+
+void EventDetectorChannel::on_sample_appended()
+{
+	batch_samples_.clear();
+	batch_timestamps_.clear();
+
+	double upper = level_ + hysteresis_ / 2;
+	double lower = level_ - hysteresis_ / 2;
+
+	size_t signal_sample_count = signal_->sample_count();
+	while (next_signal_pos_ < signal_sample_count) {
+		auto sample = signal_->get_sample(next_signal_pos_, false);
+		double timestamp = sample.first;
+		double value = sample.second;
+		++next_signal_pos_;
+
+		if (state_ == State::Unknown) {
+			state_ = value >= level_ ? State::High : State::Low;
+			rising_crossing_timestamp_ = timestamp;
+			falling_crossing_timestamp_ = timestamp;
+			last_timestamp_ = timestamp;
+			last_value_ = value;
+			continue;
+		}
+
+		// Remember the (interpolated) crossings of the level itself, the
+		// event is only triggered when the hysteresis band is left.
+		if (last_value_ < level_ && value >= level_) {
+			rising_crossing_timestamp_ = last_timestamp_ +
+				(timestamp - last_timestamp_) *
+				(level_ - last_value_) / (value - last_value_);
+		}
+		else if (last_value_ >= level_ && value < level_) {
+			falling_crossing_timestamp_ = last_timestamp_ +
+				(timestamp - last_timestamp_) *
+				(last_value_ - level_) / (last_value_ - value);
+		}
+		last_timestamp_ = timestamp;
+		last_value_ = value;
+
+		bool rising;
+		double event_timestamp;
+		if (state_ == State::Low && value >= upper && value >= level_) {
+			state_ = State::High;
+			rising = true;
+			event_timestamp = rising_crossing_timestamp_;
+		}
+		else if (state_ == State::High && value < lower && value < level_) {
+			state_ = State::Low;
+			rising = false;
+			event_timestamp = falling_crossing_timestamp_;
+		}
+		else {
+			continue;
+		}
+
+		if ((rising && edge_ == EventEdge::Falling) ||
+				(!rising && edge_ == EventEdge::Rising))
+			continue;
+
+		// Keep the index sorted, even for odd timestamps from the source.
+		if (!event_timestamps_.empty() &&
+				event_timestamp < event_timestamps_.back())
+			event_timestamp = event_timestamps_.back();
+
+		event_timestamps_.push_back(event_timestamp);
+		event_rising_.push_back(rising);
+		batch_samples_.push_back(level_);
+		batch_timestamps_.push_back(event_timestamp);
+		Q_EMIT event_added(event_timestamp, rising);
+	}
+
+	if (!batch_samples_.empty())
+		push_samples(batch_samples_, batch_timestamps_);
+}
+
+void EventDetectorChannel::on_samples_cleared()
+{
+	next_signal_pos_ = 0;
+	state_ = State::Unknown;
+	event_timestamps_.clear();
+	event_rising_.clear();
+}
+
+} // namespace channels
+} // namespace sv
@@ -0,0 +1,157 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2020 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CHANNELS_EVENTDETECTORCHANNEL_HPP
+#define CHANNELS_EVENTDETECTORCHANNEL_HPP
+
+#include <cstdint>
+#include <memory>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <QObject>
+
+#include "src/channels/basechannel.hpp"
+#include "src/channels/mathchannel.hpp"
+#include "src/data/datautil.hpp"
+
+using std::pair;
+using std::set;
+using std::shared_ptr;
+using std::string;
+using std::vector;
+
+namespace sv {
+
+namespace data {
+class AnalogTimeSignal;
+}
+
+namespace devices {
+class BaseDevice;
+}
+
+namespace channels {
+
+enum class EventEdge {
+	Rising,
+	Falling,
+	Both
+};
+
+/**
+ * Detects the crossings of a signal through a threshold level.
+ *
+ * A crossing is only recorded, when the signal has passed the hysteresis band
+ * (level +/- hysteresis/2), the timestamp of the event is the linearly
+ * interpolated crossing of the level itself. The events are stored in a
+ * sorted event index that can be searched in O(log n). Every event is also
+ * pushed as a sample (with the level as value) to the signal of the channel.
+ */
+class EventDetectorChannel : public MathChannel
+{
+	Q_OBJECT
+
+public:
+	EventDetectorChannel(
+		data::Quantity quantity,
+		set<data::QuantityFlag> quantity_flags,
+		data::Unit unit,
+		shared_ptr<data::AnalogTimeSignal> signal,
+		double level,
+		double hysteresis,
+		EventEdge edge,
+		shared_ptr<devices::BaseDevice> parent_device,
+		set<string> channel_group_names,
+		string channel_name,
+		double channel_start_timestamp);
+
+	double level() const;
+	double hysteresis() const;
+	EventEdge edge() const;
+
+	/**
+	 * Return the number of detected events.
+	 */
+	size_t event_count() const;
+
+	/**
+	 * Return the event at the given position. The first value is the
+	 * timestamp, the second value is true for a rising edge.
+	 */
+	pair<double, bool> get_event(size_t pos, bool relative_time) const;
+
+	/**
+	 * Return the position of the first event after the given timestamp or
+	 * -1 if there is no such event.
+	 */
+	int64_t next_event(double timestamp, bool relative_time) const;
+
+	/**
+	 * Return the position of the last event before the given timestamp or
+	 * -1 if there is no such event.
+	 */
+	int64_t previous_event(double timestamp, bool relative_time) const;
+
+	/**
+	 * Return the timestamps of all events between start_timestamp and
+	 * end_timestamp (both inclusive).
+	 */
+	vector<double> events_between(double start_timestamp,
+		double end_timestamp, bool relative_time) const;
+
+private:
+	enum class State {
+		Unknown,
+		Low,
+		High
+	};
+
+	shared_ptr<data::AnalogTimeSignal> signal_;
+	double level_;
+	double hysteresis_;
+	EventEdge edge_;
+	size_t next_signal_pos_;
+	State state_;
+	double last_timestamp_;
+	double last_value_;
+	double rising_crossing_timestamp_;
+	double falling_crossing_timestamp_;
+
+	vector<double> event_timestamps_;
+	vector<bool> event_rising_;
+
+	vector<double> batch_samples_;
+	vector<double> batch_timestamps_;
+
+private Q_SLOTS:
+	void on_sample_appended();
+	void on_samples_cleared();
+
+Q_SIGNALS:
+	void event_added(double timestamp, bool rising);
+
+};
+
+} // namespace channels
+} // namespace sv
+
+#endif // CHANNELS_EVENTDETECTORCHANNEL_HPP
@@ -0,0 +1,179 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2020 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <memory>
+#include <set>
+#include <string>
+
+#include <QDebug>
+
+#include "fftchannel.hpp"
+#include "src/channels/basechannel.hpp"
+#include "src/channels/mathchannel.hpp"
+#include "src/data/analogsamplesignal.hpp"
+#include "src/data/analogtimesignal.hpp"
+#include "src/data/datautil.hpp"
+#include "src/data/fft.hpp"
+#include "src/devices/basedevice.hpp"
+
+using std::make_shared;
+using std::set;
+using std::string;
+
+namespace sv {
+namespace channels {
+
+FftChannel::FftChannel(
+		data::Quantity quantity,
+		set<data::QuantityFlag> quantity_flags,
+		data::Unit unit,
+		shared_ptr<data::AnalogTimeSignal> signal,
+		size_t fft_size,
+		size_t overlap,
+		data::WindowFunction window,
+		shared_ptr<devices::BaseDevice> parent_device,
+		set<string> channel_group_names,
+		string channel_name,
+		double channel_start_timestamp) :
+	MathChannel(quantity, quantity_flags, unit,
+		parent_device, channel_group_names, channel_name,
+		channel_start_timestamp),
+	signal_(signal),
+	spectrum_signal_(nullptr),
+	fft_(fft_size, window),
+	overlap_(overlap),
+	frame_fill_(0),
+	frequency_resolution_(0.),
+	frame_count_(0),
+	next_signal_pos_(0)
+{
+	assert(signal_);
+	assert(overlap_ < fft_size);
+
+	digits_ = signal_->digits();
+	decimal_places_ = signal_->decimal_places();
+
+	frame_samples_.resize(fft_size);
+	frame_timestamps_.resize(fft_size);
+	amplitudes_.resize(fft_.bin_count());
+
+	connect(signal_.get(), SIGNAL(sample_appended()),
+		this, SLOT(on_sample_appended()));
+}
+
+shared_ptr<data::AnalogSampleSignal> FftChannel::spectrum_signal()
+{
+	/*
+	 * TODO: Remove shared_from_this() / (channel pointer in signal), so that
+	 *       the spectrum signal can be created in the ctor.
+	 */
+	if (!spectrum_signal_) {
+		spectrum_signal_ = make_shared<data::AnalogSampleSignal>(
+			quantity_, quantity_flags_, unit_, shared_from_this());
+	}
+	return spectrum_signal_;
+}
+
+size_t FftChannel::fft_size() const
+{
+	return fft_.size();
+}
+
+size_t FftChannel::bin_count() const
+{
+	return fft_.bin_count();
+}
+
+double FftChannel::frequency_resolution() const
+{
+	return frequency_resolution_;
+}
+
+size_t FftChannel::frame_count() const
+{
+	return frame_count_;
+}
+
+void FftChannel::process_frame()
+{
+	size_t fft_size = fft_.size();
+
+	fft_.amplitude_spectrum(frame_samples_.data(), amplitudes_.data());
+
+	// Derive the samplerate from the timestamps of the frame.
+	double frame_time =
+		frame_timestamps_[fft_size-1] - frame_timestamps_[0];
+	if (frame_time > 0) {
+		double sample_interval = frame_time / (double)(fft_size - 1);
+		frequency_resolution_ = 1. / (sample_interval * (double)fft_size);
+	}
+
+	auto spectrum = spectrum_signal();
+	spectrum->clear();
+	spectrum->push_samples(amplitudes_.data(), amplitudes_.size(), 0,
+		size_of_double_, digits_, decimal_places_);
+
+	// AC RMS value of the (not windowed) frame
+	double mean = 0.;
+	for (size_t i=0; i<fft_size; ++i)
+		mean += frame_samples_[i];
+	mean /= (double)fft_size;
+	double sum_sq = 0.;
+	for (size_t i=0; i<fft_size; ++i) {
+		double ac = frame_samples_[i] - mean;
+		sum_sq += ac * ac;
+	}
+	push_sample(sqrt(sum_sq / (double)fft_size),
+		frame_timestamps_[fft_size-1]);
+
+	++frame_count_;
+	Q_EMIT spectrum_updated();
+}
+
+void FftChannel::on_sample_appended()
+{
+	size_t fft_size = fft_.size();
+	size_t signal_sample_count = signal_->sample_count();
+	while (next_signal_pos_ < signal_sample_count) {
+		auto sample = signal_->get_sample(next_signal_pos_, false);
+		frame_timestamps_[frame_fill_] = sample.first;
+		frame_samples_[frame_fill_] = sample.second;
+		++frame_fill_;
+		++next_signal_pos_;
+
+		if (frame_fill_ < fft_size)
+			continue;
+
+		process_frame();
+
+		// Keep the overlapping samples for the next frame.
+		size_t hop = fft_size - overlap_;
+		std::copy(frame_samples_.begin() + hop, frame_samples_.end(),
+			frame_samples_.begin());
+		std::copy(frame_timestamps_.begin() + hop, frame_timestamps_.end(),
+			frame_timestamps_.begin());
+		frame_fill_ = overlap_;
+	}
+}
+
+} // namespace channels
+} // namespace sv
@@ -0,0 +1,131 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2020 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CHANNELS_FFTCHANNEL_HPP
+#define CHANNELS_FFTCHANNEL_HPP
+
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <QObject>
+
+#include "src/channels/basechannel.hpp"
+#include "src/channels/mathchannel.hpp"
+#include "src/data/datautil.hpp"
+#include "src/data/fft.hpp"
+
+using std::set;
+using std::shared_ptr;
+using std::string;
+using std::vector;
+
+namespace sv {
+
+namespace data {
+class AnalogSampleSignal;
+class AnalogTimeSignal;
+}
+
+namespace devices {
+class BaseDevice;
+}
+
+namespace channels {
+
+/**
+ * Calculates the amplitude spectrum of a signal with a fixed samplerate.
+ *
+ * The incoming samples are collected into frames of fft_size samples, that
+ * overlap by overlap samples. For every complete frame, the amplitude
+ * spectrum is written into the spectrum signal (bin number as position) and
+ * the AC RMS value of the frame is pushed to the (time) signal of the channel.
+ */
+class FftChannel : public MathChannel
+{
+	Q_OBJECT
+
+public:
+	FftChannel(
+		data::Quantity quantity,
+		set<data::QuantityFlag> quantity_flags,
+		data::Unit unit,
+		shared_ptr<data::AnalogTimeSignal> signal,
+		size_t fft_size,
+		size_t overlap,
+		data::WindowFunction window,
+		shared_ptr<devices::BaseDevice> parent_device,
+		set<string> channel_group_names,
+		string channel_name,
+		double channel_start_timestamp);
+
+	/**
+	 * Return the signal with the amplitude spectrum of the last frame.
+	 */
+	shared_ptr<data::AnalogSampleSignal> spectrum_signal();
+
+	/**
+	 * Return the transform size.
+	 */
+	size_t fft_size() const;
+
+	/**
+	 * Return the number of spectrum bins (fft_size / 2 + 1).
+	 */
+	size_t bin_count() const;
+
+	/**
+	 * Return the frequency resolution in Hz of the last frame. The
+	 * samplerate is derived from the timestamps of the frame.
+	 */
+	double frequency_resolution() const;
+
+	/**
+	 * Return the number of spectrum frames calculated so far.
+	 */
+	size_t frame_count() const;
+
+private:
+	void process_frame();
+
+	shared_ptr<data::AnalogTimeSignal> signal_;
+	shared_ptr<data::AnalogSampleSignal> spectrum_signal_;
+	data::FFT fft_;
+	size_t overlap_;
+	vector<double> frame_samples_;
+	vector<double> frame_timestamps_;
+	size_t frame_fill_;
+	vector<double> amplitudes_;
+	double frequency_resolution_;
+	size_t frame_count_;
+	size_t next_signal_pos_;
+
+private Q_SLOTS:
+	void on_sample_appended();
+
+Q_SIGNALS:
+	void spectrum_updated();
+
+};
+
+} // namespace channels
+} // namespace sv
+
+#endif // CHANNELS_FFTCHANNEL_HPP
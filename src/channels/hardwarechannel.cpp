@@ -22,6 +22,7 @@
 #include <set>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include <QDebug>
 
@@ -40,6 +41,7 @@ using std::set;
 using std::static_pointer_cast;
 using std::string;
 using std::unique_ptr;
+using std::vector;
 using sv::data::measured_quantity_t;
 
 namespace sv {
@@ -61,25 +63,12 @@ HardwareChannel::HardwareChannel(
 
 void HardwareChannel::push_interleaved_samples(const float *data,
 	size_t sample_count, size_t stride, double timestamp, uint64_t samplerate,
-	shared_ptr<sigrok::Analog> sr_analog)
+	const vector<double> &timestamps,
+	data::Quantity quantity, set<data::QuantityFlag> quantity_flags,
+	data::Unit unit, int sr_digits, unsigned int unit_size)
 {
 	//lock_guard<recursive_mutex> lock(mutex_);
 
-	/*
-	 * NOTE: Sometimes the mq is not set (e.g. for the demo driver in
-	 *       sigrok 6.0.0) and mq() just throws an exception, without a
-	 *       possibility to check if mq is set or not.
-	 */
-	data::Quantity quantity;
-	try {
-		quantity = data::datautil::get_quantity(sr_analog->mq());
-	}
-	catch(sigrok::Error &e) {
-		quantity = data::Quantity::Unknown;
-	}
-	set<data::QuantityFlag> quantity_flags =
-		data::datautil::get_quantity_flags(sr_analog->mq_flags());
-
 	if (!actual_signal_ || actual_signal_->quantity() != quantity ||
 		actual_signal_->quantity_flags() != quantity_flags) {
 
@@ -87,7 +76,6 @@ void HardwareChannel::push_interleaved_samples(const float *data,
 		measured_quantity_t mq = make_pair(quantity, quantity_flags);
 		size_t signals_count = signal_map_.count(mq);
 		if (signals_count == 0) {
-			data::Unit unit = data::datautil::get_unit(sr_analog->unit());
 			add_signal(quantity, quantity_flags, unit);
 			qWarning() << "HardwareChannel::push_sample_sr_analog(): " <<
 				display_name() << " - No signal found: " <<
@@ -108,10 +96,23 @@ void HardwareChannel::push_interleaved_samples(const float *data,
 	 */
 	int digits = 7;
 	int decimal_places = -1;
-	if (sr_analog->digits() >= 0)
-		decimal_places = sr_analog->digits();
+	if (sr_digits >= 0)
+		decimal_places = sr_digits;
 	else
-		digits = -1 * sr_analog->digits(); // TODO
+		digits = -1 * sr_digits; // TODO
+
+	auto signal = static_pointer_cast<data::AnalogTimeSignal>(actual_signal_);
+
+	if (!timestamps.empty()) {
+		assert(timestamps.size() == sample_count);
+		vector<double> samples(sample_count);
+		for (size_t i = 0; i < sample_count; i++) {
+			samples[i] = (double)(*data);
+			data += stride;
+		}
+		signal->push_samples(timestamps, samples, digits, decimal_places);
+		return;
+	}
 
 	// Deinterleave the samples and add them
 	unique_ptr<float[]> deint_data(new float[sample_count]);
@@ -122,9 +123,9 @@ void HardwareChannel::push_interleaved_samples(const float *data,
 		data += stride;
 	}
 
-	static_pointer_cast<data::AnalogTimeSignal>(actual_signal_)->push_samples(
+	signal->push_samples(
 		deint_data.get(), sample_count, timestamp, samplerate,
-		sr_analog->unitsize(), digits, decimal_places);
+		unit_size, digits, decimal_places);
 }
 
 } // namespace channels
@@ -23,6 +23,7 @@
 #include <memory>
 #include <set>
 #include <string>
+#include <vector>
 
 #include <QObject>
 
@@ -31,6 +32,7 @@
 using std::set;
 using std::shared_ptr;
 using std::string;
+using std::vector;
 
 namespace sigrok {
 class Analog;
@@ -62,11 +64,16 @@ public:
 
 public:
 	/**
-	 * Add one or more interleaved samples with timestamps to the channel
+	 * Add one or more interleaved samples with timestamps to the channel.
+	 * If timestamps is empty, the samples start at timestamp and are spaced
+	 * by the samplerate, otherwise timestamps holds the timestamp of every
+	 * sample.
 	 */
 	void push_interleaved_samples(const float *data, size_t sample_count,
 		size_t stride, double timestamp, uint64_t samplerate,
-		shared_ptr<sigrok::Analog> sr_analog);
+		const vector<double> &timestamps,
+		data::Quantity quantity, set<data::QuantityFlag> quantity_flags,
+		data::Unit unit, int sr_digits, unsigned int unit_size);
 
 };
 
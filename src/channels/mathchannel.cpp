@@ -21,6 +21,7 @@
 #include <memory>
 #include <set>
 #include <string>
+#include <vector>
 
 #include <QDebug>
 
@@ -34,6 +35,7 @@
 using std::set;
 using std::static_pointer_cast;
 using std::string;
+using std::vector;
 using sv::data::measured_quantity_t;
 
 namespace sv {
@@ -98,5 +100,12 @@ void MathChannel::push_sample(double sample, double timestamp)
 		size_of_double_, digits_, decimal_places_);
 }
 
+void MathChannel::push_samples(const vector<double> &samples,
+	const vector<double> &timestamps)
+{
+	auto signal = static_pointer_cast<data::AnalogTimeSignal>(actual_signal_);
+	signal->push_samples(timestamps, samples, digits_, decimal_places_);
+}
+
 } // namespace channels
 } // namespace sv
@@ -85,6 +85,12 @@ protected:
 	 */
 	void push_sample(double sample, double timestamp);
 
+	/**
+	 * Add multiple samples with timestamps to the channel/signal at once
+	 */
+	void push_samples(const vector<double> &samples,
+		const vector<double> &timestamps);
+
 	int digits_;
 	int decimal_places_;
 	data::Quantity quantity_;
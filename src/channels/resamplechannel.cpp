@@ -0,0 +1,162 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2020 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cassert>
+#include <cmath>
+#include <memory>
+#include <set>
+#include <string>
+
+#include <QDebug>
+
+#include "resamplechannel.hpp"
+#include "src/channels/basechannel.hpp"
+#include "src/channels/mathchannel.hpp"
+#include "src/data/analogtimesignal.hpp"
+#include "src/data/datautil.hpp"
+#include "src/devices/basedevice.hpp"
+
+using std::set;
+using std::string;
+
+namespace sv {
+namespace channels {
+
+ResampleChannel::ResampleChannel(
+		data::Quantity quantity,
+		set<data::QuantityFlag> quantity_flags,
+		data::Unit unit,
+		shared_ptr<data::AnalogTimeSignal> signal,
+		double rate,
+		ResampleInterpolation interpolation,
+		shared_ptr<devices::BaseDevice> parent_device,
+		set<string> channel_group_names,
+		string channel_name,
+		double channel_start_timestamp) :
+	MathChannel(quantity, quantity_flags, unit,
+		parent_device, channel_group_names, channel_name,
+		channel_start_timestamp),
+	signal_(signal),
+	interval_(1. / rate),
+	interpolation_(interpolation),
+	grid_initialized_(false),
+	next_grid_index_(0),
+	signal_pos_(0)
+{
+	assert(signal_);
+	assert(rate > 0);
+
+	digits_ = signal_->digits();
+	decimal_places_ = signal_->decimal_places();
+
+	connect(signal_.get(), SIGNAL(sample_appended()),
+		this, SLOT(on_sample_appended()));
+}
+
+double ResampleChannel::rate() const
+{
+	return 1. / interval_;
+}
+
+ResampleInterpolation ResampleChannel::interpolation() const
+{
+	return interpolation_;
+}
+
+double ResampleChannel::interpolate(double timestamp) const
+{
+	// signal_pos_ is the last sample with a timestamp <= the given timestamp
+	auto s0 = signal_->get_sample(signal_pos_, false);
+	if (interpolation_ == ResampleInterpolation::Hold || timestamp == s0.first)
+		return s0.second;
+
+	auto s1 = signal_->get_sample(signal_pos_ + 1, false);
+	double h = s1.first - s0.first;
+	double t = (timestamp - s0.first) / h;
+	if (interpolation_ == ResampleInterpolation::Linear)
+		return s0.second + (s1.second - s0.second) * t;
+
+	// Cubic Hermite spline with finite difference tangents, that also
+	// handles non-uniform sample intervals.
+	double m0;
+	if (signal_pos_ > 0) {
+		auto sm1 = signal_->get_sample(signal_pos_ - 1, false);
+		m0 = (s1.second - sm1.second) / (s1.first - sm1.first);
+	}
+	else {
+		m0 = (s1.second - s0.second) / h;
+	}
+	auto s2 = signal_->get_sample(signal_pos_ + 2, false);
+	double m1 = (s2.second - s0.second) / (s2.first - s0.first);
+
+	double t2 = t * t;
+	double t3 = t2 * t;
+	double h00 = 2 * t3 - 3 * t2 + 1;
+	double h10 = t3 - 2 * t2 + t;
+	double h01 = -2 * t3 + 3 * t2;
+	double h11 = t3 - t2;
+	return h00 * s0.second + h10 * h * m0 + h01 * s1.second + h11 * h * m1;
+}
+
+void ResampleChannel::on_sample_appended()
+{
+	size_t signal_sample_count = signal_->sample_count();
+	if (signal_sample_count == 0)
+		return;
+
+	if (!grid_initialized_) {
+		double first_ts = signal_->get_sample(0, false).first;
+		next_grid_index_ = (int64_t)ceil(first_ts / interval_);
+		if ((double)next_grid_index_ * interval_ < first_ts)
+			++next_grid_index_;
+		grid_initialized_ = true;
+	}
+
+	// Samples needed after the actual sample for the interpolation
+	size_t lookahead = 1;
+	if (interpolation_ == ResampleInterpolation::Cubic)
+		lookahead = 2;
+
+	batch_samples_.clear();
+	batch_timestamps_.clear();
+	while (true) {
+		double grid_ts = (double)next_grid_index_ * interval_;
+
+		// Find the last sample with a timestamp <= grid timestamp
+		while (signal_pos_ + 1 < signal_sample_count &&
+				signal_->get_sample(signal_pos_ + 1, false).first <= grid_ts) {
+			++signal_pos_;
+		}
+
+		// Wait for more samples if the grid point can't be calculated yet.
+		if (signal_->get_sample(signal_pos_, false).first != grid_ts &&
+				signal_pos_ + lookahead >= signal_sample_count)
+			break;
+
+		batch_samples_.push_back(interpolate(grid_ts));
+		batch_timestamps_.push_back(grid_ts);
+		++next_grid_index_;
+	}
+
+	if (!batch_samples_.empty())
+		push_samples(batch_samples_, batch_timestamps_);
+}
+
+} // namespace channels
+} // namespace sv
@@ -0,0 +1,112 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2020 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CHANNELS_RESAMPLECHANNEL_HPP
+#define CHANNELS_RESAMPLECHANNEL_HPP
+
+#include <cstdint>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <QObject>
+
+#include "src/channels/basechannel.hpp"
+#include "src/channels/mathchannel.hpp"
+#include "src/data/datautil.hpp"
+
+using std::set;
+using std::shared_ptr;
+using std::string;
+using std::vector;
+
+namespace sv {
+
+namespace data {
+class AnalogTimeSignal;
+}
+
+namespace devices {
+class BaseDevice;
+}
+
+namespace channels {
+
+enum class ResampleInterpolation {
+	Hold,
+	Linear,
+	Cubic
+};
+
+/**
+ * Resamples a signal to a uniform time grid.
+ *
+ * The grid timestamps are multiples of the sample interval (1 / rate), so
+ * all signals resampled with the same rate share exactly the same timestamps
+ * and can be combined index by index.
+ */
+class ResampleChannel : public MathChannel
+{
+	Q_OBJECT
+
+public:
+	ResampleChannel(
+		data::Quantity quantity,
+		set<data::QuantityFlag> quantity_flags,
+		data::Unit unit,
+		shared_ptr<data::AnalogTimeSignal> signal,
+		double rate,
+		ResampleInterpolation interpolation,
+		shared_ptr<devices::BaseDevice> parent_device,
+		set<string> channel_group_names,
+		string channel_name,
+		double channel_start_timestamp);
+
+	/**
+	 * Return the rate of the time grid in Hz.
+	 */
+	double rate() const;
+
+	/**
+	 * Return the interpolation mode.
+	 */
+	ResampleInterpolation interpolation() const;
+
+private:
+	double interpolate(double timestamp) const;
+
+	shared_ptr<data::AnalogTimeSignal> signal_;
+	double interval_;
+	ResampleInterpolation interpolation_;
+	bool grid_initialized_;
+	int64_t next_grid_index_;
+	size_t signal_pos_;
+	vector<double> batch_samples_;
+	vector<double> batch_timestamps_;
+
+private Q_SLOTS:
+	void on_sample_appended();
+
+};
+
+} // namespace channels
+} // namespace sv
+
+#endif // CHANNELS_RESAMPLECHANNEL_HPP
@@ -0,0 +1,163 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2020 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cassert>
+#include <deque>
+#include <memory>
+#include <set>
+#include <string>
+
+#include <QDebug>
+
+#include "windowedminmaxchannel.hpp"
+#include "src/channels/basechannel.hpp"
+#include "src/channels/mathchannel.hpp"
+#include "src/data/analogtimesignal.hpp"
+#include "src/data/datautil.hpp"
+#include "src/devices/basedevice.hpp"
+
+using std::deque;
+using std::set;
+using std::string;
+
+namespace sv {
+namespace channels {
+
+WindowedMinMaxChannel::WindowedMinMaxChannel(
+		data::Quantity quantity,
+		set<data::QuantityFlag> quantity_flags,
+		data::Unit unit,
+		shared_ptr<data::AnalogTimeSignal> signal,
+		WindowedFunction function,
+		WindowType window_type,
+		double window_size,
+		shared_ptr<devices::BaseDevice> parent_device,
+		set<string> channel_group_names,
+		string channel_name,
+		double channel_start_timestamp) :
+	MathChannel(quantity, quantity_flags, unit,
+		parent_device, channel_group_names, channel_name,
+		channel_start_timestamp),
+	signal_(signal),
+	function_(function),
+	window_type_(window_type),
+	window_size_(window_size),
+	next_signal_pos_(0)
+{
+	assert(signal_);
+	assert(window_size_ > 0);
+
+	digits_ = signal_->digits();
+	decimal_places_ = signal_->decimal_places();
+
+	connect(signal_.get(), SIGNAL(sample_appended()),
+		this, SLOT(on_sample_appended()));
+	connect(signal_.get(), SIGNAL(samples_cleared()),
+		this, SLOT(on_samples_cleared()));
+}
+
+WindowedFunction WindowedMinMaxChannel::function() const
+{
+	return function_;
+}
+
+WindowType WindowedMinMaxChannel::window_type() const
+{
+	return window_type_;
+}
+
+double WindowedMinMaxChannel::window_size() const
+{
+	return window_size_;
+}
+
+void WindowedMinMaxChannel::evict(deque<window_sample_t> &window_deque,
+	size_t pos, double timestamp)
+{
+	// Remove the samples, that have left the window, from the front.
+	if (window_type_ == WindowType::SampleCount) {
+		while (!window_deque.empty() &&
+				(double)(pos - window_deque.front().pos) >= window_size_)
+			window_deque.pop_front();
+	}
+	else {
+		while (!window_deque.empty() &&
+				timestamp - window_deque.front().timestamp > window_size_)
+			window_deque.pop_front();
+	}
+}
+
+void WindowedMinMaxChannel::on_sample_appended()
+{
+	batch_samples_.clear();
+	batch_timestamps_.clear();
+
+	bool track_max = function_ != WindowedFunction::Min;
+	bool track_min = function_ != WindowedFunction::Max;
+
+	size_t signal_sample_count = signal_->sample_count();
+	while (next_signal_pos_ < signal_sample_count) {
+		auto sample = signal_->get_sample(next_signal_pos_, false);
+		window_sample_t ws = { next_signal_pos_, sample.first, sample.second };
+
+		if (track_max) {
+			while (!max_deque_.empty() && max_deque_.back().value <= ws.value)
+				max_deque_.pop_back();
+			max_deque_.push_back(ws);
+			evict(max_deque_, ws.pos, ws.timestamp);
+		}
+		if (track_min) {
+			while (!min_deque_.empty() && min_deque_.back().value >= ws.value)
+				min_deque_.pop_back();
+			min_deque_.push_back(ws);
+			evict(min_deque_, ws.pos, ws.timestamp);
+		}
+
+		double value;
+		switch (function_) {
+		case WindowedFunction::Max:
+			value = max_deque_.front().value;
+			break;
+		case WindowedFunction::Min:
+			value = min_deque_.front().value;
+			break;
+		case WindowedFunction::PeakToPeak:
+		default:
+			value = max_deque_.front().value - min_deque_.front().value;
+			break;
+		}
+		batch_samples_.push_back(value);
+		batch_timestamps_.push_back(ws.timestamp);
+
+		++next_signal_pos_;
+	}
+
+	if (!batch_samples_.empty())
+		push_samples(batch_samples_, batch_timestamps_);
+}
+
+void WindowedMinMaxChannel::on_samples_cleared()
+{
+	next_signal_pos_ = 0;
+	max_deque_.clear();
+	min_deque_.clear();
+}
+
+} // namespace channels
+} // namespace sv
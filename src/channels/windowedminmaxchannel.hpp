@@ -0,0 +1,131 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2020 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CHANNELS_WINDOWEDMINMAXCHANNEL_HPP
+#define CHANNELS_WINDOWEDMINMAXCHANNEL_HPP
+
+#include <deque>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <QObject>
+
+#include "src/channels/basechannel.hpp"
+#include "src/channels/mathchannel.hpp"
+#include "src/data/datautil.hpp"
+
+using std::deque;
+using std::set;
+using std::shared_ptr;
+using std::string;
+using std::vector;
+
+namespace sv {
+
+namespace data {
+class AnalogTimeSignal;
+}
+
+namespace devices {
+class BaseDevice;
+}
+
+namespace channels {
+
+enum class WindowedFunction {
+	Max,
+	Min,
+	PeakToPeak
+};
+
+enum class WindowType {
+	/**
+	 * The window contains the last n samples
+	 */
+	SampleCount,
+	/**
+	 * The window contains the samples of the last n seconds
+	 */
+	TimeSpan
+};
+
+/**
+ * Calculates the maximum, minimum or peak-to-peak value of a signal over a
+ * sliding window.
+ *
+ * The extrema are tracked with monotonic deques, so every sample is added
+ * and removed at most once (amortized O(1) per sample).
+ */
+class WindowedMinMaxChannel : public MathChannel
+{
+	Q_OBJECT
+
+public:
+	WindowedMinMaxChannel(
+		data::Quantity quantity,
+		set<data::QuantityFlag> quantity_flags,
+		data::Unit unit,
+		shared_ptr<data::AnalogTimeSignal> signal,
+		WindowedFunction function,
+		WindowType window_type,
+		double window_size,
+		shared_ptr<devices::BaseDevice> parent_device,
+		set<string> channel_group_names,
+		string channel_name,
+		double channel_start_timestamp);
+
+	WindowedFunction function() const;
+	WindowType window_type() const;
+	double window_size() const;
+
+private:
+	struct window_sample_t {
+		size_t pos;
+		double timestamp;
+		double value;
+	};
+
+	void evict(deque<window_sample_t> &window_deque,
+		size_t pos, double timestamp);
+
+	shared_ptr<data::AnalogTimeSignal> signal_;
+	WindowedFunction function_;
+	WindowType window_type_;
+	double window_size_;
+	size_t next_signal_pos_;
+	/** Decreasing values, the front is the maximum of the window. */
+	deque<window_sample_t> max_deque_;
+	/** Increasing values, the front is the minimum of the window. */
+	deque<window_sample_t> min_deque_;
+
+	vector<double> batch_samples_;
+	vector<double> batch_timestamps_;
+
+private Q_SLOTS:
+	void on_sample_appended();
+	void on_samples_cleared();
+
+};
+
+} // namespace channels
+} // namespace sv
+
+#endif // CHANNELS_WINDOWEDMINMAXCHANNEL_HPP
@@ -136,6 +136,56 @@ void AnalogSampleSignal::push_sample(void *sample, uint32_t pos,
 		Q_EMIT digits_changed(digits_, decimal_places_);
 }
 
+void AnalogSampleSignal::push_samples(void *data, uint64_t samples,
+	uint32_t first_pos, size_t unit_size, int digits, int decimal_places)
+{
+	if (samples == 0)
+		return;
+
+	double dsample = 0.;
+	uint32_t pos = first_pos;
+
+	// TODO: Mutex?
+	pos_->reserve(pos_->size() + samples);
+	data_->reserve(data_->size() + samples);
+	for (uint64_t i=0; i<samples; ++i) {
+		if (unit_size == size_of_float_)
+			dsample = (double) ((float *)data)[i];
+		else if (unit_size == size_of_double_)
+			dsample = ((double *)data)[i];
+
+		if (min_value_ > dsample)
+			min_value_ = dsample;
+		// Ignore infinitiy (overflow) as max value.
+		if (max_value_ < dsample &&
+			dsample != std::numeric_limits<double>::infinity()) {
+
+			max_value_ = dsample;
+		}
+
+		pos_->push_back(pos);
+		data_->push_back(dsample);
+		++pos;
+		++sample_count_;
+	}
+
+	last_pos_ = pos - 1;
+	last_value_ = dsample;
+	Q_EMIT sample_appended();
+
+	bool digits_chngd = false;
+	if (digits != digits_) {
+		digits_ = digits;
+		digits_chngd = true;
+	}
+	if (decimal_places != decimal_places_) {
+		decimal_places_ = decimal_places;
+		digits_chngd = true;
+	}
+	if (digits_chngd)
+		Q_EMIT digits_changed(digits_, decimal_places_);
+}
+
 uint32_t AnalogSampleSignal::first_pos() const
 {
 	if (pos_->empty())
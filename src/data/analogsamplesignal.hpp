@@ -67,6 +67,13 @@ public:
 	void push_sample(void *sample, uint32_t pos,
 		size_t unit_size, int digits, int decimal_places);
 
+	/**
+	 * Push multiple samples with consecutive positions to the signal,
+	 * starting at position first_pos. sample_appended() is only emitted once.
+	 */
+	void push_samples(void *data, uint64_t samples, uint32_t first_pos,
+		size_t unit_size, int digits, int decimal_places);
+
 	uint32_t first_pos() const;
 	uint32_t last_pos() const;
 
@@ -117,7 +117,7 @@ bool AnalogTimeSignal::get_value_at_timestamp(
 
 	// Check if timestamp and found timestamp match
 	if (timestamp == *lower) {
-		value = *lower;
+		value = data_->at(lower - time_->begin());
 		return true;
 	}
 
@@ -270,6 +270,48 @@ void AnalogTimeSignal::push_samples(void *data,
 		Q_EMIT digits_changed(digits_, decimal_places_);
 }
 
+void AnalogTimeSignal::push_samples(const vector<double> &timestamps,
+	const vector<double> &samples, int digits, int decimal_places)
+{
+	assert(timestamps.size() == samples.size());
+
+	if (samples.empty())
+		return;
+
+	// TODO: Mutex?
+	for (const double &dsample : samples) {
+		if (min_value_ > dsample)
+			min_value_ = dsample;
+		// Ignore infinitiy (overflow) as max value.
+		if (max_value_ < dsample &&
+			dsample != std::numeric_limits<double>::infinity()) {
+
+			max_value_ = dsample;
+		}
+	}
+
+	// TODO: Limit memory!
+	time_->insert(time_->end(), timestamps.begin(), timestamps.end());
+	data_->insert(data_->end(), samples.begin(), samples.end());
+	sample_count_ += samples.size();
+
+	last_timestamp_ = timestamps.back();
+	last_value_ = samples.back();
+	Q_EMIT sample_appended();
+
+	bool digits_chngd = false;
+	if (digits != digits_) {
+		digits_ = digits;
+		digits_chngd = true;
+	}
+	if (decimal_places != decimal_places_) {
+		decimal_places_ = decimal_places;
+		digits_chngd = true;
+	}
+	if (digits_chngd)
+		Q_EMIT digits_changed(digits_, decimal_places_);
+}
+
 double AnalogTimeSignal::signal_start_timestamp() const
 {
 	return signal_start_timestamp_;
@@ -97,6 +97,26 @@ public:
 	void push_samples(void *data, uint64_t samples, double timestamp,
 		uint64_t samplerate, size_t unit_size, int digits, int decimal_places);
 
+	/**
+	 * Push multiple samples with individual timestamps to the signal.
+	 * sample_appended() is only emitted once.
+	 */
+	void push_samples(const vector<double> &timestamps,
+		const vector<double> &samples, int digits, int decimal_places);
+
+	/**
+	 * Return the contiguous storage of the (absolute) timestamps. Only the
+	 * first sample_count() entries are valid. Used for bulk access without
+	 * the overhead of get_sample(), e.g. by the plot.
+	 */
+	const vector<double> &time_data() const { return *time_; }
+
+	/**
+	 * Return the contiguous storage of the sample values. Only the first
+	 * sample_count() entries are valid.
+	 */
+	const vector<double> &value_data() const { return *data_; }
+
 	double signal_start_timestamp() const;
 	double first_timestamp(bool relative_time) const;
 	double last_timestamp(bool relative_time) const;
@@ -69,6 +69,13 @@ uint32_t get_sr_quantity_id(Quantity quantity)
 	return 0;
 }
 
+const sigrok::Quantity *get_sr_quantity(Quantity quantity)
+{
+	if (quantity_sr_quantity_map.count(quantity) > 0)
+		return quantity_sr_quantity_map[quantity];
+	return nullptr;
+}
+
 
 QuantityFlag get_quantity_flag(const sigrok::QuantityFlag *sr_quantity_flag)
 {
@@ -126,6 +133,19 @@ uint64_t get_sr_quantity_flags_id(set<QuantityFlag> quantity_flags)
 	return sr_qfs_id;
 }
 
+vector<const sigrok::QuantityFlag *> get_sr_quantity_flags(
+	set<QuantityFlag> quantity_flags)
+{
+	vector<const sigrok::QuantityFlag *> sr_quantity_flags;
+	for (const auto &quantity_flag : quantity_flags) {
+		if (quantity_flag_sr_quantity_flag_map.count(quantity_flag) > 0) {
+			sr_quantity_flags.push_back(
+				quantity_flag_sr_quantity_flag_map[quantity_flag]);
+		}
+	}
+	return sr_quantity_flags;
+}
+
 
 Unit get_unit(const sigrok::Unit *sr_unit)
 {
@@ -134,6 +154,13 @@ Unit get_unit(const sigrok::Unit *sr_unit)
 	return Unit::Unknown;
 }
 
+const sigrok::Unit *get_sr_unit(Unit unit)
+{
+	if (unit_sr_unit_map.count(unit) > 0)
+		return unit_sr_unit_map[unit];
+	return nullptr;
+}
+
 
 DataType get_data_type(const sigrok::DataType *sr_data_type)
 {
@@ -287,6 +314,15 @@ set<data::Unit> get_units_from_quantity(data::Quantity quantity)
 	return units;
 }
 
+data::Quantity get_quantity_from_unit(data::Unit unit)
+{
+	for (const auto &q_u_pair : quantity_unit_map) {
+		if (q_u_pair.second.count(unit) > 0)
+			return q_u_pair.first;
+	}
+	return data::Quantity::Unknown;
+}
+
 } // namespace datautil
 } // namespace data
 } // namespace sv
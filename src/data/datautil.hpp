@@ -704,6 +704,15 @@ Quantity get_quantity(uint32_t sr_quantity);
  */
 uint32_t get_sr_quantity_id(Quantity quantity);
 
+/**
+ * Return the corresponding sigrok Quantity for a Quantity
+ *
+ * @param quantity The Quantity
+ *
+ * @return The sigrok Quantity or nullptr if there is no sigrok Quantity.
+ */
+const sigrok::Quantity *get_sr_quantity(Quantity quantity);
+
 /**
  * Check if the quantity is a known sigrok quantity
  *
@@ -762,6 +771,16 @@ set<QuantityFlag> get_quantity_flags(uint64_t sr_quantity_flags);
  */
 uint64_t get_sr_quantity_flags_id(set<QuantityFlag> quantity_flags);
 
+/**
+ * Return the corresponding sigrok QuantityFlags as a vector
+ *
+ * @param quantity_flags The QuantityFlags as set
+ *
+ * @return The sigrok QuantityFlags as vector
+ */
+vector<const sigrok::QuantityFlag *> get_sr_quantity_flags(
+	set<QuantityFlag> quantity_flags);
+
 
 /**
  * Return the corresponding Unit for a sigrok Unit
@@ -772,6 +791,15 @@ uint64_t get_sr_quantity_flags_id(set<QuantityFlag> quantity_flags);
  */
 Unit get_unit(const sigrok::Unit *sr_unit);
 
+/**
+ * Return the corresponding sigrok Unit for a Unit
+ *
+ * @param unit The Unit
+ *
+ * @return The sigrok Unit or nullptr if there is no sigrok Unit.
+ */
+const sigrok::Unit *get_sr_unit(Unit unit);
+
 
 /**
  * Return the corresponding DataType for a sigrok DataType
@@ -895,6 +923,15 @@ QString format_data_type(DataType data_type);
  */
 set<data::Unit> get_units_from_quantity(data::Quantity quantity);
 
+/**
+ * Return the first quantity, that is measured in the given unit
+ *
+ * @param unit The unit
+ *
+ * @return The quantity or Quantity::Unknown
+ */
+data::Quantity get_quantity_from_unit(data::Unit unit);
+
 } // namespace datautil
 } // namespace data
 } // namespace sv
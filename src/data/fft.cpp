@@ -0,0 +1,177 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2020 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#include "fft.hpp"
+
+using std::vector;
+
+namespace sv {
+namespace data {
+
+FFT::FFT(size_t size, WindowFunction window) :
+	size_(size),
+	half_size_(size / 2),
+	window_(window),
+	window_sum_(0.)
+{
+	assert(is_valid_size(size_));
+
+	// Periodic window coefficients, as usual for spectral analysis.
+	window_coeffs_.resize(size_);
+	for (size_t n=0; n<size_; ++n) {
+		double phi = 2 * M_PI * n / (double)size_;
+		double w;
+		switch (window_) {
+		case WindowFunction::Blackman:
+			w = 0.42 - 0.5 * cos(phi) + 0.08 * cos(2 * phi);
+			break;
+		case WindowFunction::Hann:
+		default:
+			w = 0.5 - 0.5 * cos(phi);
+			break;
+		}
+		window_coeffs_[n] = w;
+		window_sum_ += w;
+	}
+
+	// Bit reversal table for the complex FFT of half the size
+	size_t bits = 0;
+	while (((size_t)1 << bits) < half_size_)
+		++bits;
+	bit_reverse_.resize(half_size_);
+	for (size_t i=0; i<half_size_; ++i) {
+		size_t rev = 0;
+		for (size_t b=0; b<bits; ++b) {
+			if (i & ((size_t)1 << b))
+				rev |= (size_t)1 << (bits - 1 - b);
+		}
+		bit_reverse_[i] = rev;
+	}
+
+	// Twiddle factors for each stage of the complex FFT
+	stage_twiddle_re_.reserve(half_size_);
+	stage_twiddle_im_.reserve(half_size_);
+	for (size_t len=2; len<=half_size_; len<<=1) {
+		for (size_t j=0; j<len/2; ++j) {
+			double phi = 2 * M_PI * j / (double)len;
+			stage_twiddle_re_.push_back(cos(phi));
+			stage_twiddle_im_.push_back(-sin(phi));
+		}
+	}
+
+	// Twiddle factors to split the packed spectrum into the real spectrum
+	split_twiddle_re_.resize(half_size_);
+	split_twiddle_im_.resize(half_size_);
+	for (size_t k=0; k<half_size_; ++k) {
+		double phi = 2 * M_PI * k / (double)size_;
+		split_twiddle_re_[k] = cos(phi);
+		split_twiddle_im_[k] = -sin(phi);
+	}
+
+	re_.resize(half_size_);
+	im_.resize(half_size_);
+}
+
+size_t FFT::size() const
+{
+	return size_;
+}
+
+size_t FFT::bin_count() const
+{
+	return half_size_ + 1;
+}
+
+WindowFunction FFT::window() const
+{
+	return window_;
+}
+
+void FFT::amplitude_spectrum(const double *input, double *amplitude)
+{
+	// Pack the windowed real input into a complex sequence of half the
+	// size (even samples -> real part, odd samples -> imaginary part) and
+	// store it in bit reversed order.
+	for (size_t k=0; k<half_size_; ++k) {
+		size_t pos = bit_reverse_[k];
+		re_[pos] = input[2*k] * window_coeffs_[2*k];
+		im_[pos] = input[2*k+1] * window_coeffs_[2*k+1];
+	}
+
+	transform();
+
+	// DC and Nyquist bins
+	double norm = 1. / window_sum_;
+	amplitude[0] = fabs(re_[0] + im_[0]) * norm;
+	amplitude[half_size_] = fabs(re_[0] - im_[0]) * norm;
+
+	// Split the packed spectrum into the spectrum of the real input
+	norm *= 2.;
+	for (size_t k=1; k<half_size_; ++k) {
+		size_t m = half_size_ - k;
+		double even_re = (re_[k] + re_[m]) / 2;
+		double even_im = (im_[k] - im_[m]) / 2;
+		double odd_re = (im_[k] + im_[m]) / 2;
+		double odd_im = (re_[m] - re_[k]) / 2;
+		double w_re = split_twiddle_re_[k];
+		double w_im = split_twiddle_im_[k];
+		double x_re = even_re + w_re * odd_re - w_im * odd_im;
+		double x_im = even_im + w_re * odd_im + w_im * odd_re;
+		amplitude[k] = sqrt(x_re * x_re + x_im * x_im) * norm;
+	}
+}
+
+void FFT::transform()
+{
+	size_t twiddle_offset = 0;
+	for (size_t len=2; len<=half_size_; len<<=1) {
+		size_t half = len / 2;
+		const double *w_re = &stage_twiddle_re_[twiddle_offset];
+		const double *w_im = &stage_twiddle_im_[twiddle_offset];
+		for (size_t i=0; i<half_size_; i+=len) {
+			double *a_re = &re_[i];
+			double *a_im = &im_[i];
+			double *b_re = &re_[i + half];
+			double *b_im = &im_[i + half];
+			for (size_t j=0; j<half; ++j) {
+				double t_re = b_re[j] * w_re[j] - b_im[j] * w_im[j];
+				double t_im = b_re[j] * w_im[j] + b_im[j] * w_re[j];
+				b_re[j] = a_re[j] - t_re;
+				b_im[j] = a_im[j] - t_im;
+				a_re[j] += t_re;
+				a_im[j] += t_im;
+			}
+		}
+		twiddle_offset += half;
+	}
+}
+
+bool FFT::is_valid_size(size_t size)
+{
+	// The real input is packed into a complex FFT of half the size.
+	return size >= 4 && (size & (size - 1)) == 0;
+}
+
+} // namespace data
+} // namespace sv
@@ -0,0 +1,106 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2020 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef DATA_FFT_HPP
+#define DATA_FFT_HPP
+
+#include <cstddef>
+#include <vector>
+
+using std::vector;
+
+namespace sv {
+namespace data {
+
+enum class WindowFunction {
+	Hann,
+	Blackman
+};
+
+/**
+ * Radix-2 FFT for real input data of a fixed (power of two) size.
+ *
+ * All tables (window, bit reversal and twiddle factors) are computed once in
+ * the constructor, so transforming a frame doesn't allocate any memory. The
+ * real input is packed into a complex sequence of half the size, real and
+ * imaginary parts are kept in separate arrays and the twiddle factors are
+ * stored contiguously per stage, so the butterfly loops run with unit stride
+ * and can be vectorized by the compiler.
+ */
+class FFT
+{
+
+public:
+	FFT(size_t size, WindowFunction window);
+
+	/**
+	 * Return the transform size (number of input samples).
+	 */
+	size_t size() const;
+
+	/**
+	 * Return the number of output bins (size / 2 + 1).
+	 */
+	size_t bin_count() const;
+
+	/**
+	 * Return the window function.
+	 */
+	WindowFunction window() const;
+
+	/**
+	 * Apply the window to the first size() samples of the input and calculate
+	 * the single-sided amplitude spectrum. The amplitudes are corrected by the
+	 * coherent gain of the window, so a sine with the amplitude A shows up as
+	 * a peak with the height A.
+	 *
+	 * @param input The input samples, at least size() samples.
+	 * @param amplitude The output amplitudes, at least bin_count() values.
+	 */
+	void amplitude_spectrum(const double *input, double *amplitude);
+
+	/**
+	 * Check if the given size is a valid transform size.
+	 */
+	static bool is_valid_size(size_t size);
+
+private:
+	void transform();
+
+	size_t size_;
+	size_t half_size_;
+	WindowFunction window_;
+	vector<double> window_coeffs_;
+	double window_sum_;
+	vector<size_t> bit_reverse_;
+	/** Twiddle factors for the complex FFT, stored contiguously per stage. */
+	vector<double> stage_twiddle_re_;
+	vector<double> stage_twiddle_im_;
+	/** Twiddle factors for splitting the packed real spectrum. */
+	vector<double> split_twiddle_re_;
+	vector<double> split_twiddle_im_;
+	vector<double> re_;
+	vector<double> im_;
+
+};
+
+} // namespace data
+} // namespace sv
+
+#endif // DATA_FFT_HPP
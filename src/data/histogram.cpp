@@ -0,0 +1,140 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2020 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#include "histogram.hpp"
+
+using std::vector;
+
+namespace sv {
+namespace data {
+
+Histogram::Histogram(size_t bin_count) :
+	counts_(bin_count, 0),
+	merged_counts_(bin_count, 0),
+	has_range_(false),
+	min_(0.),
+	max_(0.),
+	bin_width_(0.),
+	total_count_(0)
+{
+	assert(bin_count > 0);
+}
+
+void Histogram::add(double value)
+{
+	if (!std::isfinite(value))
+		return;
+
+	if (!has_range_)
+		init_range(value);
+	else if (value < min_ || value > max_)
+		extend_range(value);
+
+	++counts_[bin_index(value)];
+	++total_count_;
+}
+
+void Histogram::remove(double value)
+{
+	if (!std::isfinite(value) || !has_range_ || value < min_ || value > max_)
+		return;
+
+	size_t &count = counts_[bin_index(value)];
+	if (count == 0)
+		return;
+	--count;
+	--total_count_;
+}
+
+void Histogram::clear()
+{
+	std::fill(counts_.begin(), counts_.end(), 0);
+	has_range_ = false;
+	min_ = 0.;
+	max_ = 0.;
+	bin_width_ = 0.;
+	total_count_ = 0;
+}
+
+void Histogram::set_range(double min, double max)
+{
+	clear();
+	if (!(max > min))
+		return;
+
+	min_ = min;
+	max_ = max;
+	bin_width_ = (max_ - min_) / (double)counts_.size();
+	has_range_ = true;
+}
+
+size_t Histogram::max_count() const
+{
+	return *std::max_element(counts_.begin(), counts_.end());
+}
+
+void Histogram::init_range(double value)
+{
+	// Start with a small range around the first value, the range grows
+	// quickly (by doubling) to the spread of the values.
+	double half_width = std::fabs(value) * 1e-6;
+	if (half_width <= 0)
+		half_width = 1e-9;
+	set_range(value - half_width, value + half_width);
+}
+
+void Histogram::extend_range(double value)
+{
+	const size_t bin_count = counts_.size();
+	while (value < min_ || value > max_) {
+		std::fill(merged_counts_.begin(), merged_counts_.end(), 0);
+		if (value > max_) {
+			// Keep min, the old bins are merged into the lower half.
+			for (size_t i=0; i<bin_count; ++i)
+				merged_counts_[i / 2] += counts_[i];
+			max_ = min_ + 2 * (max_ - min_);
+		}
+		else {
+			// Keep max, the old bins are merged into the upper half.
+			for (size_t i=0; i<bin_count; ++i)
+				merged_counts_[(bin_count + i) / 2] += counts_[i];
+			min_ = max_ - 2 * (max_ - min_);
+		}
+		counts_.swap(merged_counts_);
+		bin_width_ = (max_ - min_) / (double)bin_count;
+	}
+}
+
+size_t Histogram::bin_index(double value) const
+{
+	size_t index = (size_t)((value - min_) / bin_width_);
+	// The upper boundary belongs to the last bin.
+	if (index >= counts_.size())
+		index = counts_.size() - 1;
+	return index;
+}
+
+} // namespace data
+} // namespace sv
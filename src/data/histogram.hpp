@@ -0,0 +1,93 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2020 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef DATA_HISTOGRAM_HPP
+#define DATA_HISTOGRAM_HPP
+
+#include <cstddef>
+#include <vector>
+
+using std::vector;
+
+namespace sv {
+namespace data {
+
+/**
+ * Histogram with a fixed number of equally sized bins.
+ *
+ * Adding and removing a value is O(1). When a value is added outside of the
+ * range, the range is doubled (to the side of the value) until the value
+ * fits. Doubling the range merges two neighbouring bins into one, so the
+ * histogram stays exact without touching the samples again.
+ */
+class Histogram
+{
+
+public:
+	explicit Histogram(size_t bin_count);
+
+	/**
+	 * Add a value. Non finite values are ignored.
+	 */
+	void add(double value);
+
+	/**
+	 * Remove a value, that has been added before (e.g. for a sliding window).
+	 */
+	void remove(double value);
+
+	/**
+	 * Remove all values and the range.
+	 */
+	void clear();
+
+	/**
+	 * Remove all values and set a new range. The range will still be
+	 * extended by values outside of the range.
+	 */
+	void set_range(double min, double max);
+
+	bool has_range() const { return has_range_; }
+	double min() const { return min_; }
+	double max() const { return max_; }
+	double bin_width() const { return bin_width_; }
+	size_t bin_count() const { return counts_.size(); }
+	size_t count(size_t bin) const { return counts_[bin]; }
+	size_t total_count() const { return total_count_; }
+	size_t max_count() const;
+
+private:
+	void init_range(double value);
+	void extend_range(double value);
+	size_t bin_index(double value) const;
+
+	vector<size_t> counts_;
+	vector<size_t> merged_counts_;
+	bool has_range_;
+	double min_;
+	double max_;
+	double bin_width_;
+	size_t total_count_;
+
+};
+
+} // namespace data
+} // namespace sv
+
+#endif // DATA_HISTOGRAM_HPP
@@ -93,6 +93,11 @@ public Q_SLOTS:
 Q_SIGNALS:
 	void value_changed(const QVariant qvar);
 	void list_changed();
+	/**
+	 * A queued value has been send to the device. The latency in ms is
+	 * measured from queueing the value until the device has been set.
+	 */
+	void value_set(bool success, double latency);
 
 };
 
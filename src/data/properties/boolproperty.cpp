@@ -67,7 +67,7 @@ bool BoolProperty::list_config()
 
 void BoolProperty::change_value(const QVariant qvar)
 {
-	configurable_->set_config(config_key_, qvar.toBool());
+	configurable_->queue_set_config(config_key_, qvar.toBool());
 	Q_EMIT value_changed(qvar);
 }
 
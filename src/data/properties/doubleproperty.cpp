@@ -122,7 +122,7 @@ bool DoubleProperty::list_config()
 
 void DoubleProperty::change_value(const QVariant qvar)
 {
-	configurable_->set_config(config_key_, qvar.toDouble());
+	configurable_->queue_set_config(config_key_, qvar.toDouble());
 	Q_EMIT value_changed(qvar);
 }
 
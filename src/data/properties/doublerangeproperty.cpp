@@ -141,7 +141,7 @@ void DoubleRangeProperty::change_value(const QVariant qvar)
 	gcontainer.push_back(gvar_low);
 	gcontainer.push_back(gvar_high);
 
-	configurable_->set_container_config(config_key_, gcontainer);
+	configurable_->queue_set_container_config(config_key_, gcontainer);
 	Q_EMIT value_changed(qvar);
 }
 
@@ -106,7 +106,7 @@ bool Int32Property::list_config()
 
 void Int32Property::change_value(const QVariant qvar)
 {
-	configurable_->set_config(config_key_, qvar.toInt());
+	configurable_->queue_set_config(config_key_, qvar.toInt());
 	Q_EMIT value_changed(qvar);
 }
 
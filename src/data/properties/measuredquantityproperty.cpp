@@ -156,7 +156,7 @@ void MeasuredQuantityProperty::change_value(const QVariant qvar)
 	gcontainer.push_back(gvar_q);
 	gcontainer.push_back(gvar_qfs);
 
-	configurable_->set_container_config(config_key_, gcontainer);
+	configurable_->queue_set_container_config(config_key_, gcontainer);
 	Q_EMIT value_changed(qvar);
 }
 
@@ -152,7 +152,7 @@ void RationalProperty::change_value(const QVariant qvar)
 	gcontainer.push_back(gvar_p);
 	gcontainer.push_back(gvar_q);
 
-	configurable_->set_container_config(config_key_, gcontainer);
+	configurable_->queue_set_container_config(config_key_, gcontainer);
 	Q_EMIT value_changed(qvar);
 }
 
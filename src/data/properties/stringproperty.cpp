@@ -94,7 +94,7 @@ void StringProperty::change_value(const QVariant qvar)
 {
 	// We have to use Glib::ustring here, to get a variant type of 's'.
 	// std::string will create a variant type of 'ay'
-	configurable_->set_config<Glib::ustring>(
+	configurable_->queue_set_config<Glib::ustring>(
 		config_key_, Glib::ustring(qvar.toString().toStdString()));
 	Q_EMIT value_changed(qvar);
 }
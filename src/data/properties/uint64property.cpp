@@ -176,7 +176,7 @@ void UInt64Property::change_value(const QVariant qvar)
 			new_qvar.setValue((qulonglong)20000);
 	}
 
-	configurable_->set_config(config_key_, (uint64_t)new_qvar.toULongLong());
+	configurable_->queue_set_config(config_key_, (uint64_t)new_qvar.toULongLong());
 	Q_EMIT value_changed(new_qvar);
 }
 
@@ -148,7 +148,7 @@ void UInt64RangeProperty::change_value(const QVariant qvar)
 	gcontainer.push_back(gvar_low);
 	gcontainer.push_back(gvar_high);
 
-	configurable_->set_container_config(config_key_, gcontainer);
+	configurable_->queue_set_container_config(config_key_, gcontainer);
 	Q_EMIT value_changed(qvar);
 }
 
@@ -18,21 +18,24 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
 #include <cassert>
+#include <chrono>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <thread>
 
 #include <glib.h>
 
 #include <libsigrokcxx/libsigrokcxx.hpp>
 
-#include <QApplication>
 #include <QDebug>
+#include <QMetaObject>
 #include <QObject>
-#include <QProgressDialog>
 
 #include "devicemanager.hpp"
 #include "src/util.hpp"
@@ -43,7 +46,9 @@
 #include "src/devices/sourcesinkdevice.hpp"
 
 using std::bind;
+using std::lock_guard;
 using std::list;
+using std::make_shared;
 using std::map;
 using std::multimap;
 using std::pair;
@@ -51,23 +56,29 @@ using std::placeholders::_1;
 using std::placeholders::_2;
 using std::shared_ptr;
 using std::string;
+using std::unique_lock;
 using std::unique_ptr;
 using std::vector;
 
 using Glib::VariantBase;
 
+/** Maximum number of concurrent driver scans */
+#define SCAN_THREADS_MAX 8
+/** Time in ms after which the scan of a single driver is given up */
+#define DRIVER_SCAN_TIMEOUT 15000
+#define SCAN_TIMER_INTERVAL 250
+
 namespace sv {
 
 DeviceManager::DeviceManager(shared_ptr<sigrok::Context> context,
 		vector<string> drivers, bool do_scan) :
-	context_(context)
+	context_(context),
+	scan_state_(make_shared<scan_state_t>()),
+	is_scanning_(false),
+	user_spec_jobs_pending_(0)
 {
-	unique_ptr<QProgressDialog> progress(new QProgressDialog("",
-		QObject::tr("Cancel"), 0, (int)context->drivers().size() + 1));
-	progress->setWindowModality(Qt::WindowModal);
-	progress->setMinimumDuration(1);  // To show the dialog immediately
-
-	int entry_num = 1;
+	scan_state_->next_job = 0;
+	scan_state_->canceled = false;
 
 	/*
 	 * Check the presence of optional user specs for device scans.
@@ -86,55 +97,96 @@ DeviceManager::DeviceManager(shared_ptr<sigrok::Context> context,
 		}
 	}
 
+	/*
+	 * Optionally run another scan with potentially more specific
+	 * options when requested by the user. This is motivated by
+	 * several different uses: It can find devices that are not
+	 * covered by the auto detection (UART, TCP). It can
+	 * prefer one out of multiple found devices, and have this
+	 * device pre-selected for new sessions upon user's request.
+	 *
+	 * The user specified drivers are queued first, so their devices show
+	 * up as early as possible.
+	 */
+	const auto sr_drivers = context->drivers();
+	for (auto it = user_drvs_name_opts.begin(), end = user_drvs_name_opts.end();
+			it != end; it = user_drvs_name_opts.upper_bound(it->first)) {
+		const auto entry = sr_drivers.find(it->first);
+		if (entry == sr_drivers.end())
+			continue;
+		if (!devices::deviceutil::is_supported_driver(entry->second))
+			continue;
+
+		auto job = make_shared<scan_job_t>();
+		job->sr_driver = entry->second;
+		if (!it->second.empty()) {
+			job->drvopts = driver_scan_options(
+				it->second, entry->second->scan_options());
+		}
+		job->is_user_spec = true;
+		job->state = ScanState::Waiting;
+		scan_state_->jobs.push_back(job);
+		++user_spec_jobs_pending_;
+	}
+
 	/*
 	 * Scan for devices. No specific options apply here, this is
 	 * best effort auto detection.
 	 */
-	for (const auto &entry : context->drivers()) {
+	for (const auto &entry : sr_drivers) {
 		if (!do_scan)
 			break;
 
 		// Skip drivers we won't scan anyway
 		if (!devices::deviceutil::is_supported_driver(entry.second))
 			continue;
-
-		progress->setLabelText(QObject::tr("Scanning for %1...")
-			.arg(QString::fromStdString(entry.first)));
-
 		if (user_drvs_name_opts.count(entry.first) > 0)
 			continue;
-		driver_scan(entry.second, map<const sigrok::ConfigKey *, VariantBase>());
 
-		progress->setValue(entry_num++);
-		QApplication::processEvents();
-		if (progress->wasCanceled())
-			break;
+		auto job = make_shared<scan_job_t>();
+		job->sr_driver = entry.second;
+		job->is_user_spec = false;
+		job->state = ScanState::Waiting;
+		scan_state_->jobs.push_back(job);
+	}
+
+	if (scan_state_->jobs.empty())
+		return;
+
+	is_scanning_ = true;
+	connect(&scan_timer_, SIGNAL(timeout()), this, SLOT(on_scan_timer()));
+	scan_timer_.start(SCAN_TIMER_INTERVAL);
+
+	const size_t thread_count = std::min(
+		scan_state_->jobs.size(), (size_t)SCAN_THREADS_MAX);
+	for (size_t i=0; i<thread_count; ++i)
+		start_scan_thread();
+}
+
+DeviceManager::~DeviceManager()
+{
+	set<std::thread::id> timed_out_threads;
+	{
+		lock_guard<mutex> lock(scan_state_->scan_mutex);
+		scan_state_->canceled = true;
+		timed_out_threads = scan_state_->timed_out_threads;
 	}
 
 	/*
-	 * Optionally run another scan with potentially more specific
-	 * options when requested by the user. This is motivated by
-	 * several different uses: It can find devices that are not
-	 * covered by the above auto detection (UART, TCP). It can
-	 * prefer one out of multiple found devices, and have this
-	 * device pre-selected for new sessions upon user's request.
+	 * The running scans can't be aborted, wait for them to finish. Threads
+	 * stuck in a driver, that has timed out, are left behind. They only use
+	 * the shared scan state and their job, never the device manager. The
+	 * job holds a reference to the sigrok driver, which keeps the sigrok
+	 * context alive (and sr_exit() from being called), so the left behind
+	 * scan can't use a context, that has already been destroyed. The thread
+	 * is terminated together with the process.
 	 */
-	user_spec_devices_.clear();
- 	if (!drivers.empty() && !user_drvs_name_opts.empty()) {
-		for( auto it = user_drvs_name_opts.begin(), end = user_drvs_name_opts.end();
-			it != end;
- 			it = user_drvs_name_opts.upper_bound(it->first)) {
-
-			auto user_drv_name = it->first;
-			auto user_drv_opts = it->second;
-
-			list< shared_ptr<devices::HardwareDevice> > found =
-				driver_scan(user_drv_name, user_drv_opts);
-			if (!found.empty())
-				user_spec_devices_.push_back(found.front());
-		}
+	for (auto &thread : scan_threads_) {
+		if (timed_out_threads.count(thread.get_id()))
+			thread.detach();
+		else if (thread.joinable())
+			thread.join();
 	}
-	progress->setValue(entry_num++);
 }
 
 const shared_ptr<sigrok::Context>& DeviceManager::context() const
@@ -162,6 +214,16 @@ DeviceManager::user_spec_devices() const
 	return user_spec_devices_;
 }
 
+bool DeviceManager::is_scanning() const
+{
+	return is_scanning_;
+}
+
+bool DeviceManager::is_user_spec_scanning() const
+{
+	return user_spec_jobs_pending_ > 0;
+}
+
 /**
  * Convert generic options to data types that are specific to Driver::scan().
  *
@@ -259,14 +321,35 @@ DeviceManager::driver_scan(
 	if (!devices::deviceutil::is_supported_driver(sr_driver))
 		return driver_devices;
 
+	// The driver may still be scanned by the background scan. Don't wait
+	// here, the scan thread could be stuck in the driver.
+	auto scan_mutex = driver_mutex(scan_state_, sr_driver);
+	unique_lock<mutex> driver_lock(*scan_mutex, std::try_to_lock);
+	if (!driver_lock.owns_lock()) {
+		qWarning() << "DeviceManager::driver_scan(): Driver " <<
+			QString::fromStdString(sr_driver->name()) <<
+			" is still scanned in the background";
+		return driver_devices;
+	}
+
+	// Do the scan
+	auto sr_devices = sr_driver->scan(drvopts);
+	driver_lock.unlock();
+
+	return add_scanned_devices(sr_driver, sr_devices);
+}
+
+list<shared_ptr<devices::HardwareDevice>> DeviceManager::add_scanned_devices(
+	shared_ptr<sigrok::Driver> sr_driver,
+	vector<shared_ptr<sigrok::HardwareDevice>> sr_devices)
+{
+	list< shared_ptr<devices::HardwareDevice> > driver_devices;
+
 	// Remove any device instances from this driver from the device
 	// list. They will not be valid after the scan.
 	devices_.remove_if([&](shared_ptr<devices::HardwareDevice> device) {
 		return device->sr_hardware_device()->driver() == sr_driver; });
 
-	// Do the scan
-	auto sr_devices = sr_driver->scan(drvopts);
-
 	// Add the scanned devices to the main list, set display names and sort.
 	for (const auto &sr_device : sr_devices) {
 		if (devices::deviceutil::is_source_sink_driver(sr_driver)) {
@@ -287,6 +370,144 @@ DeviceManager::driver_scan(
 	return driver_devices;
 }
 
+shared_ptr<mutex> DeviceManager::driver_mutex(shared_ptr<scan_state_t> state,
+	shared_ptr<sigrok::Driver> sr_driver)
+{
+	lock_guard<mutex> lock(state->scan_mutex);
+	auto &driver_mutex = state->driver_mutexes[sr_driver];
+	if (!driver_mutex)
+		driver_mutex = make_shared<mutex>();
+	return driver_mutex;
+}
+
+void DeviceManager::start_scan_thread()
+{
+	scan_threads_.push_back(
+		std::thread(&DeviceManager::scan_thread_proc, scan_state_, this));
+}
+
+void DeviceManager::scan_thread_proc(shared_ptr<scan_state_t> state,
+	DeviceManager *device_manager)
+{
+	while (true) {
+		shared_ptr<scan_job_t> job;
+		{
+			lock_guard<mutex> lock(state->scan_mutex);
+			if (state->canceled || state->next_job >= state->jobs.size())
+				return;
+			job = state->jobs[state->next_job++];
+			job->state = ScanState::Running;
+			job->start_time = std::chrono::steady_clock::now();
+			job->thread_id = std::this_thread::get_id();
+		}
+
+		vector<shared_ptr<sigrok::HardwareDevice>> sr_devices;
+		auto scan_mutex = driver_mutex(state, job->sr_driver);
+		{
+			lock_guard<mutex> driver_lock(*scan_mutex);
+			try {
+				sr_devices = job->sr_driver->scan(job->drvopts);
+			}
+			catch (sigrok::Error &e) {
+				qWarning() << "DeviceManager::scan_thread_proc(): Scan of " <<
+					QString::fromStdString(job->sr_driver->name()) <<
+					" failed: " << e.what();
+			}
+		}
+
+		lock_guard<mutex> lock(state->scan_mutex);
+		// A replacement thread has been started for a timed out scan.
+		if (job->state == ScanState::TimedOut)
+			return;
+		job->sr_devices = sr_devices;
+		job->state = ScanState::Finished;
+		if (state->canceled)
+			return;
+		state->finished_jobs.push_back(job);
+		// The devices must be created in the GUI thread.
+		QMetaObject::invokeMethod(device_manager, "on_scan_result_ready",
+			Qt::QueuedConnection);
+	}
+}
+
+void DeviceManager::check_scan_finished()
+{
+	{
+		lock_guard<mutex> lock(scan_state_->scan_mutex);
+		if (!scan_state_->finished_jobs.empty())
+			return;
+		for (const auto &job : scan_state_->jobs) {
+			if (job->state == ScanState::Waiting ||
+					job->state == ScanState::Running)
+				return;
+		}
+	}
+
+	scan_timer_.stop();
+	is_scanning_ = false;
+	Q_EMIT scan_finished();
+}
+
+void DeviceManager::on_scan_result_ready()
+{
+	list<shared_ptr<scan_job_t>> finished_jobs;
+	{
+		lock_guard<mutex> lock(scan_state_->scan_mutex);
+		finished_jobs.swap(scan_state_->finished_jobs);
+	}
+
+	for (const auto &job : finished_jobs) {
+		auto found = add_scanned_devices(job->sr_driver, job->sr_devices);
+		for (const auto &device : found)
+			Q_EMIT device_found(device);
+
+		if (job->is_user_spec) {
+			--user_spec_jobs_pending_;
+			if (!found.empty()) {
+				user_spec_devices_.push_back(found.front());
+				Q_EMIT user_spec_device_found(found.front());
+			}
+			if (user_spec_jobs_pending_ == 0)
+				Q_EMIT user_spec_scan_finished();
+		}
+	}
+
+	check_scan_finished();
+}
+
+void DeviceManager::on_scan_timer()
+{
+	const auto now = std::chrono::steady_clock::now();
+	size_t timed_out_count = 0;
+	const size_t user_spec_jobs_pending = user_spec_jobs_pending_;
+	{
+		lock_guard<mutex> lock(scan_state_->scan_mutex);
+		for (const auto &job : scan_state_->jobs) {
+			if (job->state != ScanState::Running ||
+					now - job->start_time <
+					std::chrono::milliseconds(DRIVER_SCAN_TIMEOUT))
+				continue;
+
+			qWarning() << "DeviceManager::on_scan_timer(): Scan of " <<
+				QString::fromStdString(job->sr_driver->name()) << " timed out";
+			job->state = ScanState::TimedOut;
+			scan_state_->timed_out_threads.insert(job->thread_id);
+			if (job->is_user_spec)
+				--user_spec_jobs_pending_;
+			++timed_out_count;
+		}
+	}
+
+	// Replace the stuck threads, so the pool size is kept.
+	for (size_t i=0; i<timed_out_count; ++i)
+		start_scan_thread();
+
+	if (user_spec_jobs_pending > 0 && user_spec_jobs_pending_ == 0)
+		Q_EMIT user_spec_scan_finished();
+
+	check_scan_finished();
+}
+
 map<string, string> DeviceManager::get_device_info(
 	shared_ptr<devices::BaseDevice> device)
 {
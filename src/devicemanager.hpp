@@ -21,15 +21,22 @@
 #ifndef DEVICEMANAGER_HPP
 #define DEVICEMANAGER_HPP
 
+#include <chrono>
 #include <list>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <string>
+#include <thread>
 #include <vector>
 
+#include <QObject>
+#include <QTimer>
+
 using std::list;
 using std::map;
+using std::mutex;
 using std::set;
 using std::shared_ptr;
 using std::string;
@@ -43,6 +50,7 @@ namespace sigrok {
 class ConfigKey;
 class Context;
 class Driver;
+class HardwareDevice;
 }
 
 namespace sv {
@@ -52,14 +60,25 @@ class BaseDevice;
 class HardwareDevice;
 }
 
-class DeviceManager
+/**
+ * The device manager scans the drivers for devices.
+ *
+ * The startup scan runs in the background: The drivers are scanned
+ * concurrently by a bounded pool of scan threads and the found devices are
+ * added (in the GUI thread) as soon as the scan of a driver has finished. A
+ * driver, that doesn't finish its scan within the timeout, is given up and
+ * its thread is replaced, so that slow (serial) drivers don't hold up the
+ * remaining drivers.
+ */
+class DeviceManager : public QObject
 {
+	Q_OBJECT
 
 public:
 	DeviceManager(shared_ptr<sigrok::Context> context,
 		vector<std::string> drivers, bool do_scan);
 
-	~DeviceManager() = default;
+	~DeviceManager();
 
 	const shared_ptr<sigrok::Context> &context() const;
 
@@ -68,6 +87,17 @@ public:
 	const list<shared_ptr<devices::HardwareDevice>> &devices() const;
 	list<shared_ptr<devices::HardwareDevice>> user_spec_devices() const;
 
+	/**
+	 * Return true while the startup scan is running.
+	 */
+	bool is_scanning() const;
+
+	/**
+	 * Return true while drivers with user provided scan options (from the
+	 * command line) are still scanned.
+	 */
+	bool is_user_spec_scanning() const;
+
 	list<shared_ptr<devices::HardwareDevice>> driver_scan(
 		string driver_name, vector<string> driver_opts);
 
@@ -82,9 +112,57 @@ public:
 		const map<string, string> search_info);
 
 private:
+	enum class ScanState {
+		Waiting,
+		Running,
+		Finished,
+		TimedOut
+	};
+
+	struct scan_job_t
+	{
+		shared_ptr<sigrok::Driver> sr_driver;
+		map<const sigrok::ConfigKey *, Glib::VariantBase> drvopts;
+		bool is_user_spec;
+		ScanState state;
+		std::chrono::steady_clock::time_point start_time;
+		std::thread::id thread_id;
+		vector<shared_ptr<sigrok::HardwareDevice>> sr_devices;
+	};
+
+	/**
+	 * The state of the startup scan, that is shared with the scan threads.
+	 * A scan thread, that has timed out, may outlive the device manager.
+	 */
+	struct scan_state_t
+	{
+		mutex scan_mutex;
+		vector<shared_ptr<scan_job_t>> jobs;
+		size_t next_job;
+		list<shared_ptr<scan_job_t>> finished_jobs;
+		set<std::thread::id> timed_out_threads;
+		/**
+		 * Serializes the scans of a driver. A scan thread, that has timed
+		 * out, keeps the lock until its scan returns.
+		 */
+		map<shared_ptr<sigrok::Driver>, shared_ptr<mutex>> driver_mutexes;
+		bool canceled;
+	};
+
 	bool compare_devices(shared_ptr<devices::BaseDevice> a,
 		shared_ptr<devices::BaseDevice> b);
 
+	list<shared_ptr<devices::HardwareDevice>> add_scanned_devices(
+		shared_ptr<sigrok::Driver> sr_driver,
+		vector<shared_ptr<sigrok::HardwareDevice>> sr_devices);
+
+	static shared_ptr<mutex> driver_mutex(shared_ptr<scan_state_t> state,
+		shared_ptr<sigrok::Driver> sr_driver);
+	void start_scan_thread();
+	void check_scan_finished();
+	static void scan_thread_proc(shared_ptr<scan_state_t> state,
+		DeviceManager *device_manager);
+
 	static map<const sigrok::ConfigKey *, Glib::VariantBase>
 	driver_scan_options(vector<string> user_spec,
 		set<const sigrok::ConfigKey *> driver_opts);
@@ -94,6 +172,33 @@ protected:
 	list<shared_ptr<devices::HardwareDevice>> devices_;
 	list<shared_ptr<devices::HardwareDevice>> user_spec_devices_;
 
+private:
+	shared_ptr<scan_state_t> scan_state_;
+	vector<std::thread> scan_threads_;
+	QTimer scan_timer_;
+	bool is_scanning_;
+	size_t user_spec_jobs_pending_;
+
+Q_SIGNALS:
+	/**
+	 * A device has been found by the startup scan.
+	 */
+	void device_found(shared_ptr<sv::devices::HardwareDevice> device);
+	/**
+	 * A device has been found with user provided scan options.
+	 */
+	void user_spec_device_found(shared_ptr<sv::devices::HardwareDevice> device);
+	/**
+	 * All drivers with user provided scan options have been scanned (or
+	 * have timed out).
+	 */
+	void user_spec_scan_finished();
+	void scan_finished();
+
+private Q_SLOTS:
+	void on_scan_result_ready();
+	void on_scan_timer();
+
 };
 
 } // namespace sv
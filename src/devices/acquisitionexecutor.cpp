@@ -0,0 +1,250 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2020 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <cassert>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include <glib.h>
+
+#include <QDebug>
+
+#include <libsigrokcxx/libsigrokcxx.hpp>
+
+#include "acquisitionexecutor.hpp"
+
+using std::lock_guard;
+using std::make_shared;
+
+/** Interval in ms, in which the workers update their heartbeat */
+#define HEARTBEAT_INTERVAL 250
+/** A worker without a heartbeat for this time (ms) is considered as hung */
+#define HEARTBEAT_TIMEOUT 2000
+
+namespace sv {
+namespace devices {
+
+namespace {
+
+struct start_data_t
+{
+	shared_ptr<sigrok::Session> sr_session;
+	function<void(const string &)> error_callback;
+	/** Shared with stop_session(), to cancel a pending start */
+	function<bool()> begin_start;
+};
+
+gboolean start_session_cb(gpointer data)
+{
+	auto start_data = static_cast<start_data_t *>(data);
+	if (!start_data->begin_start())
+		return G_SOURCE_REMOVE;
+	try {
+		// Called in the worker thread, so the session uses the
+		// thread-default main context of the worker.
+		start_data->sr_session->start();
+	}
+	catch (sigrok::Error &e) {
+		start_data->error_callback(e.what());
+	}
+	return G_SOURCE_REMOVE;
+}
+
+void start_data_free(gpointer data)
+{
+	delete static_cast<start_data_t *>(data);
+}
+
+gboolean stop_session_cb(gpointer data)
+{
+	// Called in the worker thread after the start, so the stop can't get
+	// lost while the session is still starting.
+	try {
+		(*static_cast<shared_ptr<sigrok::Session> *>(data))->stop();
+	}
+	catch (sigrok::Error &e) {
+		qWarning() << "AcquisitionExecutor: Failed to stop session: " <<
+			e.what();
+	}
+	return G_SOURCE_REMOVE;
+}
+
+void stop_data_free(gpointer data)
+{
+	delete static_cast<shared_ptr<sigrok::Session> *>(data);
+}
+
+gboolean quit_loop_cb(gpointer data)
+{
+	g_main_loop_quit(static_cast<GMainLoop *>(data));
+	return G_SOURCE_REMOVE;
+}
+
+}
+
+AcquisitionExecutor::AcquisitionExecutor(size_t worker_count)
+{
+	assert(worker_count > 0);
+
+	lock_guard<mutex> lock(mutex_);
+	for (size_t i=0; i<worker_count; ++i)
+		add_worker();
+}
+
+AcquisitionExecutor::~AcquisitionExecutor()
+{
+	lock_guard<mutex> lock(mutex_);
+	for (const auto &worker : workers_) {
+		// Quit from within the loop, g_main_loop_quit() would get lost, if
+		// the loop isn't running yet.
+		g_main_context_invoke(worker->context, quit_loop_cb, worker->loop);
+		// A hung worker can't be joined, it keeps its own reference.
+		if (is_responsive(worker))
+			worker->thread.join();
+		else
+			worker->thread.detach();
+	}
+}
+
+void AcquisitionExecutor::start_session(shared_ptr<sigrok::Session> sr_session,
+	function<void(const string &)> error_callback)
+{
+	shared_ptr<worker_t> worker;
+	auto start_state = make_shared<atomic<StartState>>(StartState::Pending);
+	{
+		lock_guard<mutex> lock(mutex_);
+		for (const auto &w : workers_) {
+			if (!is_responsive(w))
+				continue;
+			if (!worker || w->session_count < worker->session_count)
+				worker = w;
+		}
+		if (!worker) {
+			qWarning() << "AcquisitionExecutor::start_session(): " <<
+				"No responsive worker, adding a new one";
+			worker = add_worker();
+		}
+		++worker->session_count;
+		sessions_[sr_session.get()] = { worker, start_state };
+	}
+
+	auto begin_start = [start_state]() {
+		StartState expected = StartState::Pending;
+		return start_state->compare_exchange_strong(
+			expected, StartState::Started);
+	};
+	auto start_data = new start_data_t {
+		sr_session, error_callback, begin_start };
+	g_main_context_invoke_full(worker->context, G_PRIORITY_DEFAULT,
+		start_session_cb, start_data, start_data_free);
+}
+
+bool AcquisitionExecutor::stop_session(shared_ptr<sigrok::Session> sr_session)
+{
+	session_t session;
+	{
+		lock_guard<mutex> lock(mutex_);
+		const auto it = sessions_.find(sr_session.get());
+		if (it == sessions_.end())
+			return true;
+		session = it->second;
+	}
+
+	StartState expected = StartState::Pending;
+	if (session.start_state->compare_exchange_strong(
+			expected, StartState::Cancelled))
+		return false;
+
+	g_main_context_invoke_full(session.worker->context, G_PRIORITY_DEFAULT,
+		stop_session_cb, new shared_ptr<sigrok::Session>(sr_session),
+		stop_data_free);
+	return true;
+}
+
+void AcquisitionExecutor::finish_session(shared_ptr<sigrok::Session> sr_session)
+{
+	lock_guard<mutex> lock(mutex_);
+	const auto it = sessions_.find(sr_session.get());
+	if (it == sessions_.end())
+		return;
+	--it->second.worker->session_count;
+	sessions_.erase(it);
+}
+
+size_t AcquisitionExecutor::worker_count() const
+{
+	lock_guard<mutex> lock(mutex_);
+	return workers_.size();
+}
+
+shared_ptr<AcquisitionExecutor::worker_t> AcquisitionExecutor::add_worker()
+{
+	auto worker = make_shared<worker_t>();
+	worker->context = g_main_context_new();
+	worker->loop = g_main_loop_new(worker->context, FALSE);
+	worker->heartbeat = now_ms();
+	worker->session_count = 0;
+	worker->thread = std::thread(&AcquisitionExecutor::worker_thread_proc, worker);
+	workers_.push_back(worker);
+
+	return worker;
+}
+
+bool AcquisitionExecutor::is_responsive(const shared_ptr<worker_t> &worker) const
+{
+	return now_ms() - worker->heartbeat < HEARTBEAT_TIMEOUT;
+}
+
+void AcquisitionExecutor::worker_thread_proc(shared_ptr<worker_t> worker)
+{
+	g_main_context_push_thread_default(worker->context);
+
+	GSource *heartbeat_source = g_timeout_source_new(HEARTBEAT_INTERVAL);
+	g_source_set_callback(heartbeat_source,
+		&AcquisitionExecutor::on_heartbeat, worker.get(), nullptr);
+	g_source_attach(heartbeat_source, worker->context);
+
+	g_main_loop_run(worker->loop);
+
+	g_source_destroy(heartbeat_source);
+	g_source_unref(heartbeat_source);
+	g_main_context_pop_thread_default(worker->context);
+	g_main_loop_unref(worker->loop);
+	g_main_context_unref(worker->context);
+}
+
+gboolean AcquisitionExecutor::on_heartbeat(gpointer data)
+{
+	static_cast<worker_t *>(data)->heartbeat = now_ms();
+	return G_SOURCE_CONTINUE;
+}
+
+int64_t AcquisitionExecutor::now_ms()
+{
+	return std::chrono::duration_cast<std::chrono::milliseconds>(
+		std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+} // namespace devices
+} // namespace sv
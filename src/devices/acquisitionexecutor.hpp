@@ -0,0 +1,138 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2020 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef DEVICES_ACQUISITIONEXECUTOR_HPP
+#define DEVICES_ACQUISITIONEXECUTOR_HPP
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <glib.h>
+
+using std::atomic;
+using std::function;
+using std::map;
+using std::mutex;
+using std::shared_ptr;
+using std::string;
+using std::vector;
+
+namespace sigrok {
+class Session;
+}
+
+namespace sv {
+namespace devices {
+
+/**
+ * Runs the sigrok sessions of many devices on a small pool of worker threads.
+ *
+ * Every worker thread iterates its own GLib main context. A session, that is
+ * started from a worker thread, attaches its event sources to the worker's
+ * (thread-default) main context, so the worker serves the event sources of
+ * all sessions assigned to it, instead of running one main loop per device.
+ *
+ * Each worker updates a heartbeat from its main loop. A worker, that is
+ * stuck in a driver callback, misses its heartbeat and doesn't get new
+ * sessions anymore. If there is no responsive worker left, a new one is
+ * started, so a hung device can only stall the devices on its own worker.
+ * Devices, that must not share a worker at all, can still use a dedicated
+ * acquisition thread (see BaseDevice::set_isolated_acquisition()).
+ */
+class AcquisitionExecutor
+{
+
+public:
+	explicit AcquisitionExecutor(size_t worker_count);
+	~AcquisitionExecutor();
+
+	/**
+	 * Start the session on the least loaded responsive worker. The session is
+	 * started asynchronously in the worker thread, errors are reported via
+	 * the error callback (called in the worker thread).
+	 */
+	void start_session(shared_ptr<sigrok::Session> sr_session,
+		function<void(const string &)> error_callback);
+
+	/**
+	 * Stop the session in its worker thread. If the session hasn't been
+	 * started yet, the pending start is cancelled instead.
+	 *
+	 * @return false if the start was cancelled, so the session will never
+	 *         run (and never call its stopped callback).
+	 */
+	bool stop_session(shared_ptr<sigrok::Session> sr_session);
+
+	/**
+	 * Release the worker of a session, after the session has been stopped.
+	 */
+	void finish_session(shared_ptr<sigrok::Session> sr_session);
+
+	/**
+	 * Return the number of worker threads (including unresponsive workers).
+	 */
+	size_t worker_count() const;
+
+private:
+	struct worker_t
+	{
+		GMainContext *context;
+		GMainLoop *loop;
+		std::thread thread;
+		/** Time of the last heartbeat in ms (steady clock) */
+		atomic<int64_t> heartbeat;
+		size_t session_count;
+	};
+
+	enum class StartState {
+		Pending,
+		Started,
+		Cancelled
+	};
+
+	struct session_t
+	{
+		shared_ptr<worker_t> worker;
+		shared_ptr<atomic<StartState>> start_state;
+	};
+
+	shared_ptr<worker_t> add_worker();
+	bool is_responsive(const shared_ptr<worker_t> &worker) const;
+	static void worker_thread_proc(shared_ptr<worker_t> worker);
+	static gboolean on_heartbeat(gpointer data);
+	static int64_t now_ms();
+
+	vector<shared_ptr<worker_t>> workers_;
+	map<const sigrok::Session *, session_t> sessions_;
+	mutable mutex mutex_;
+
+};
+
+} // namespace devices
+} // namespace sv
+
+#endif // DEVICES_ACQUISITIONEXECUTOR_HPP
@@ -19,6 +19,7 @@
  */
 
 #include <cassert>
+#include <chrono>
 #include <map>
 #include <memory>
 #include <mutex>
@@ -33,30 +34,58 @@
 
 #include "basedevice.hpp"
 #include "src/session.hpp"
+#include "src/sessionclock.hpp"
 #include "src/util.hpp"
 #include "src/channels/basechannel.hpp"
 #include "src/channels/hardwarechannel.hpp"
 #include "src/channels/mathchannel.hpp"
 #include "src/channels/userchannel.hpp"
 #include "src/data/basesignal.hpp"
+#include "src/data/datautil.hpp"
+#include "src/devices/acquisitionexecutor.hpp"
+#include "src/devices/configqueue.hpp"
 #include "src/devices/configurable.hpp"
 
 #define USER_CHANNEL_START_INDEX 1000
 #define CONFIGURABLE_START_INDEX 5000
+#define INGEST_QUEUE_SIZE 256
+/** Time in ms to wait for a session on the acquisition executor to stop */
+#define SESSION_STOP_TIMEOUT 5000
+/** Interval in ms for the rates in the acquisition statistics */
+#define STATISTICS_INTERVAL 1000
 
 using std::bad_alloc;
 using std::dynamic_pointer_cast;
 using std::lock_guard;
 using std::make_shared;
+using std::memory_order_relaxed;
 using std::map;
 using std::set;
 using std::shared_ptr;
+using std::static_pointer_cast;
 using std::string;
 using std::vector;
 
 namespace sv {
 namespace devices {
 
+namespace {
+
+int64_t steady_time_ns()
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(
+		std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void update_max(atomic<uint64_t> &max, uint64_t value)
+{
+	// Only the producer thread updates the max. value, the reader resets it.
+	if (value > max.load(memory_order_relaxed))
+		max.store(value, memory_order_relaxed);
+}
+
+} // namespace
+
 unsigned int BaseDevice::device_counter = 0;
 
 BaseDevice::BaseDevice(const shared_ptr<sigrok::Context> sr_context,
@@ -66,7 +95,24 @@ BaseDevice::BaseDevice(const shared_ptr<sigrok::Context> sr_context,
 	device_open_(false),
 	next_channel_index_(USER_CHANNEL_START_INDEX),
 	next_configurable_index_(CONFIGURABLE_START_INDEX),
-	frame_began_(false)
+	frame_began_(false),
+	ingest_queue_(INGEST_QUEUE_SIZE),
+	is_ingest_overflow_(false),
+	ingest_overflow_dropped_(0),
+	is_isolated_acquisition_(false),
+	is_shared_acquisition_(false),
+	is_session_stopped_(true),
+	ingest_running_(false),
+	latency_offset_(0.),
+	stat_packet_count_(0),
+	stat_sample_count_(0),
+	stat_feed_in_time_(0),
+	stat_feed_in_time_max_(0),
+	stat_ingest_count_(0),
+	stat_ingest_time_(0),
+	stat_ingest_time_max_(0),
+	stat_last_packet_time_(0),
+	stat_rates_()
 {
 	// Set up a sigrok session per smuvierw device
 	sr_session_ = sv::Session::sr_context->create_session();
@@ -80,6 +126,8 @@ BaseDevice::BaseDevice(const shared_ptr<sigrok::Context> sr_context,
 	 *       CSV, XY-Plots) can be displayed with relative timestamps.
 	 */
 	aquisition_start_timestamp_ = sv::Session::session_start_timestamp;
+
+	stat_window_ = current_statistics_window();
 }
 
 BaseDevice::~BaseDevice()
@@ -135,12 +183,40 @@ void BaseDevice::close()
 	if (!device_open_)
 		return;
 
-	sr_session_->stop();
+	for (const auto &c_pair : configurable_map_)
+		c_pair.second->stop_polling();
+	// Send the remaining queued values before closing the device.
+	if (config_queue_)
+		config_queue_->stop();
+
+	if (is_shared_acquisition_) {
+		// The session is stopped in its worker thread. If the worker hasn't
+		// started the session yet, the start is cancelled.
+		if (!Session::acquisition_executor->stop_session(sr_session_))
+			on_session_stopped();
+	}
+	else {
+		sr_session_->stop();
+	}
 
 	// Check that sampling stopped
 	if (aquisition_thread_.joinable())
 		aquisition_thread_.join();
+	if (is_shared_acquisition_) {
+		// Don't let a hung device block closing.
+		std::unique_lock<mutex> lock(session_stopped_mutex_);
+		if (!session_stopped_cv_.wait_for(lock,
+				std::chrono::milliseconds(SESSION_STOP_TIMEOUT),
+				[this]() { return is_session_stopped_; })) {
+			qWarning() << "BaseDevice::close(): Session of " <<
+				BaseDevice::full_name() << " didn't stop";
+		}
+		lock.unlock();
+		Session::acquisition_executor->finish_session(sr_session_);
+		is_shared_acquisition_ = false;
+	}
 	sr_session_->remove_datafeed_callbacks();
+	stop_ingest();
 	aquisition_state_ = AquisitionState::Stopped;
 
 	/*
@@ -178,6 +254,16 @@ void BaseDevice::pause_aquisition()
 	aquisition_state_ = AquisitionState::Paused;
 }
 
+void BaseDevice::set_isolated_acquisition(bool isolated)
+{
+	is_isolated_acquisition_ = isolated;
+}
+
+bool BaseDevice::is_isolated_acquisition() const
+{
+	return is_isolated_acquisition_;
+}
+
 string BaseDevice::name() const
 {
 	string sep;
@@ -292,6 +378,102 @@ vector<shared_ptr<data::BaseSignal>> BaseDevice::signals() const
 	return signals;
 }
 
+uint64_t BaseDevice::dropped_packet_count() const
+{
+	return ingest_queue_.dropped_packets();
+}
+
+uint64_t BaseDevice::dropped_sample_count() const
+{
+	return ingest_queue_.dropped_samples();
+}
+
+BaseDevice::statistics_window_t BaseDevice::current_statistics_window() const
+{
+	statistics_window_t window;
+	window.time = steady_time_ns();
+	window.packet_count = stat_packet_count_.load(memory_order_relaxed);
+	window.sample_count = stat_sample_count_.load(memory_order_relaxed);
+	window.feed_in_time = stat_feed_in_time_.load(memory_order_relaxed);
+	window.ingest_count = stat_ingest_count_.load(memory_order_relaxed);
+	window.ingest_time = stat_ingest_time_.load(memory_order_relaxed);
+	window.dropped_samples = ingest_queue_.dropped_samples();
+	return window;
+}
+
+acquisition_statistics_t BaseDevice::acquisition_statistics() const
+{
+	lock_guard<mutex> lock(stat_mutex_);
+
+	// The rates are calculated once per interval, so multiple readers
+	// (views, scripts) get consistent values.
+	statistics_window_t window = current_statistics_window();
+	double elapsed = (window.time - stat_window_.time) / 1e9;
+	if (elapsed >= STATISTICS_INTERVAL / 1000.) {
+		uint64_t packets = window.packet_count - stat_window_.packet_count;
+		uint64_t ingests = window.ingest_count - stat_window_.ingest_count;
+		stat_rates_.packet_rate = packets / elapsed;
+		stat_rates_.sample_rate =
+			(window.sample_count - stat_window_.sample_count) / elapsed;
+		stat_rates_.dropped_sample_rate =
+			(window.dropped_samples - stat_window_.dropped_samples) / elapsed;
+		stat_rates_.feed_in_time_avg = packets == 0 ? 0 :
+			(window.feed_in_time - stat_window_.feed_in_time) / 1e3 / packets;
+		stat_rates_.ingest_time_avg = ingests == 0 ? 0 :
+			(window.ingest_time - stat_window_.ingest_time) / 1e3 / ingests;
+		stat_rates_.feed_in_time_max =
+			stat_feed_in_time_max_.exchange(0, memory_order_relaxed) / 1e3;
+		stat_rates_.ingest_time_max =
+			stat_ingest_time_max_.exchange(0, memory_order_relaxed) / 1e3;
+		stat_window_ = window;
+	}
+
+	acquisition_statistics_t statistics = stat_rates_;
+	statistics.packet_count = window.packet_count;
+	statistics.sample_count = window.sample_count;
+	statistics.queue_depth = ingest_queue_.size();
+	statistics.queue_capacity = ingest_queue_.capacity();
+	statistics.dropped_packet_count = ingest_queue_.dropped_packets();
+	statistics.dropped_sample_count = window.dropped_samples;
+
+	int64_t last_packet_time =
+		stat_last_packet_time_.load(memory_order_relaxed);
+	statistics.time_since_last_packet = last_packet_time == 0 ? -1 :
+		(window.time - last_packet_time) / 1e9;
+
+	statistics.config_latency_last = -1;
+	statistics.config_latency_max = -1;
+	statistics.config_queue_depth = 0;
+	if (config_queue_) {
+		statistics.config_latency_last = config_queue_->last_latency();
+		statistics.config_latency_max = config_queue_->max_latency();
+		statistics.config_queue_depth = config_queue_->pending_count();
+	}
+
+	return statistics;
+}
+
+AcquisitionHealth BaseDevice::acquisition_health() const
+{
+	acquisition_statistics_t statistics = acquisition_statistics();
+	if (statistics.packet_count == 0)
+		return AcquisitionHealth::Idle;
+	if (statistics.dropped_sample_rate > 0 ||
+			statistics.queue_depth * 2 > statistics.queue_capacity)
+		return AcquisitionHealth::Lagging;
+	return AcquisitionHealth::Ok;
+}
+
+void BaseDevice::set_latency_offset(double latency_offset)
+{
+	latency_offset_.store(latency_offset, memory_order_relaxed);
+}
+
+double BaseDevice::latency_offset() const
+{
+	return latency_offset_.load(memory_order_relaxed);
+}
+
 unsigned int BaseDevice::next_channel_index()
 {
 	return next_channel_index_++;
@@ -376,15 +558,45 @@ shared_ptr<channels::UserChannel> BaseDevice::add_user_channel(
 
 void BaseDevice::init_acquisition()
 {
+	start_ingest();
+
 	sr_session_->add_datafeed_callback([=]
 		(shared_ptr<sigrok::Device> sr_device, shared_ptr<sigrok::Packet> sr_packet) {
 			data_feed_in(sr_device, sr_packet);
 		});
-	aquisition_thread_ = std::thread(
-		&BaseDevice::aquisition_thread_proc, this);
+
+	{
+		lock_guard<mutex> lock(session_stopped_mutex_);
+		is_session_stopped_ = false;
+	}
+	sr_session_->set_stopped_callback([=]() {
+		on_session_stopped();
+	});
+
+	if (Session::acquisition_executor && !is_isolated_acquisition_) {
+		is_shared_acquisition_ = true;
+		Session::acquisition_executor->start_session(sr_session_,
+			[=](const string &error) {
+				Q_EMIT device_error(name(), error);
+				on_session_stopped();
+			});
+	}
+	else {
+		aquisition_thread_ = std::thread(
+			&BaseDevice::aquisition_thread_proc, this);
+	}
 	aquisition_state_ = AquisitionState::Running;
 }
 
+void BaseDevice::on_session_stopped()
+{
+	aquisition_state_ = AquisitionState::Stopped;
+
+	lock_guard<mutex> lock(session_stopped_mutex_);
+	is_session_stopped_ = true;
+	session_stopped_cv_.notify_all();
+}
+
 void BaseDevice::data_feed_in(shared_ptr<sigrok::Device> sr_device,
 	shared_ptr<sigrok::Packet> sr_packet)
 {
@@ -437,11 +649,17 @@ void BaseDevice::data_feed_in(shared_ptr<sigrok::Device> sr_device,
 		if (aquisition_state_ != AquisitionState::Running)
 			return;
 
-		try {
-			feed_in_analog(
-				dynamic_pointer_cast<sigrok::Analog>(sr_packet->payload()));
-		} catch (bad_alloc &) {
-			//out_of_memory_ = true;
+		{
+			int64_t feed_in_start = steady_time_ns();
+			try {
+				feed_in_analog(
+					dynamic_pointer_cast<sigrok::Analog>(sr_packet->payload()));
+			} catch (bad_alloc &) {
+				//out_of_memory_ = true;
+			}
+			uint64_t feed_in_time = steady_time_ns() - feed_in_start;
+			stat_feed_in_time_.fetch_add(feed_in_time, memory_order_relaxed);
+			update_max(stat_feed_in_time_max_, feed_in_time);
 		}
 		break;
 
@@ -470,6 +688,154 @@ void BaseDevice::data_feed_in(shared_ptr<sigrok::Device> sr_device,
 	}
 }
 
+void BaseDevice::ingest_analog(const analog_packet_t &packet)
+{
+	data::Quantity quantity = data::Quantity::Unknown;
+	if (packet.sr_quantity != nullptr)
+		quantity = data::datautil::get_quantity(packet.sr_quantity);
+	set<data::QuantityFlag> quantity_flags =
+		data::datautil::get_quantity_flags(packet.sr_quantity_flags);
+	data::Unit unit = data::datautil::get_unit(packet.sr_unit);
+
+	const float *channel_data = packet.data.data();
+	for (const auto &sr_channel : packet.sr_channels) {
+		if (!sr_channel_map_.count(sr_channel))
+			assert("Unknown channel");
+		auto channel = static_pointer_cast<channels::HardwareChannel>(
+			sr_channel_map_[sr_channel]);
+
+		channel->push_interleaved_samples(channel_data++, packet.num_samples,
+			packet.sr_channels.size(), packet.timestamp, packet.samplerate,
+			packet.timestamps, quantity, quantity_flags, unit, packet.digits,
+			packet.unit_size);
+	}
+}
+
+void BaseDevice::push_analog_packet(shared_ptr<sigrok::Analog> sr_analog,
+	double timestamp, uint64_t samplerate, int digits,
+	const vector<double> *timestamps)
+{
+	size_t num_samples = sr_analog->num_samples();
+	if (num_samples == 0)
+		return;
+
+	stat_packet_count_.fetch_add(1, memory_order_relaxed);
+	stat_sample_count_.fetch_add(num_samples, memory_order_relaxed);
+	stat_last_packet_time_.store(steady_time_ns(), memory_order_relaxed);
+
+	analog_packet_t *packet = ingest_queue_.begin_push(num_samples);
+	if (packet == nullptr) {
+		if (!is_ingest_overflow_) {
+			is_ingest_overflow_ = true;
+			ingest_overflow_dropped_ = ingest_queue_.dropped_packets() - 1;
+			qWarning() << "BaseDevice::push_analog_packet(): Ingest queue of" <<
+				full_name() << "is full, dropping packets";
+		}
+		return;
+	}
+	if (is_ingest_overflow_) {
+		is_ingest_overflow_ = false;
+		qWarning() << "BaseDevice::push_analog_packet(): Ingest queue of" <<
+			full_name() << "recovered," <<
+			ingest_queue_.dropped_packets() - ingest_overflow_dropped_ <<
+			"packets dropped";
+	}
+
+	// NOTE: channels() and mq_flags() return new vectors for every packet,
+	//       libsigrokcxx has no way to read them into an existing buffer.
+	packet->num_samples = num_samples;
+	packet->sr_channels = sr_analog->channels();
+	packet->data.resize(num_samples * packet->sr_channels.size());
+	sr_analog->get_data_as_float(packet->data.data());
+
+	/*
+	 * NOTE: Sometimes the mq is not set (e.g. for the demo driver in
+	 *       sigrok 6.0.0) and mq() just throws an exception, without a
+	 *       possibility to check if mq is set or not.
+	 */
+	try {
+		packet->sr_quantity = sr_analog->mq();
+	}
+	catch (sigrok::Error &e) {
+		packet->sr_quantity = nullptr;
+	}
+	packet->sr_quantity_flags = sr_analog->mq_flags();
+	packet->sr_unit = sr_analog->unit();
+	packet->digits = digits;
+	packet->unit_size = sr_analog->unitsize();
+	const double latency_offset = latency_offset_.load(memory_order_relaxed);
+	packet->timestamp = timestamp - latency_offset;
+	packet->samplerate = samplerate;
+	packet->timestamps.clear();
+	if (timestamps) {
+		assert(timestamps->size() == num_samples);
+		for (const double &ts : *timestamps)
+			packet->timestamps.push_back(ts - latency_offset);
+	}
+
+	ingest_queue_.end_push();
+	notify_ingest();
+}
+
+void BaseDevice::notify_ingest()
+{
+	// The producer doesn't lock ingest_mutex_, a lost wake up is caught by
+	// the timeout in ingest_thread_proc().
+	ingest_cv_.notify_one();
+}
+
+void BaseDevice::start_ingest()
+{
+	if (ingest_thread_.joinable())
+		return;
+
+	ingest_running_ = true;
+	ingest_thread_ = std::thread(&BaseDevice::ingest_thread_proc, this);
+}
+
+void BaseDevice::stop_ingest()
+{
+	if (!ingest_thread_.joinable())
+		return;
+
+	ingest_running_ = false;
+	ingest_cv_.notify_one();
+	ingest_thread_.join();
+}
+
+void BaseDevice::ingest_thread_proc()
+{
+	while (true) {
+		analog_packet_t *packet = ingest_queue_.front();
+		if (!packet) {
+			// Drain the queue before stopping.
+			if (!ingest_running_)
+				break;
+			std::unique_lock<mutex> lock(ingest_mutex_);
+			ingest_cv_.wait_for(lock, std::chrono::milliseconds(10));
+			continue;
+		}
+
+		while (packet) {
+			int64_t ingest_start = steady_time_ns();
+			{
+				lock_guard<recursive_mutex> lock(data_mutex_);
+				try {
+					ingest_analog(*packet);
+				} catch (bad_alloc &) {
+					//out_of_memory_ = true;
+				}
+			}
+			uint64_t ingest_time = steady_time_ns() - ingest_start;
+			stat_ingest_count_.fetch_add(1, memory_order_relaxed);
+			stat_ingest_time_.fetch_add(ingest_time, memory_order_relaxed);
+			update_max(stat_ingest_time_max_, ingest_time);
+			ingest_queue_.pop();
+			packet = ingest_queue_.front();
+		}
+	}
+}
+
 void BaseDevice::aquisition_thread_proc()
 {
 	try {
@@ -482,10 +848,8 @@ void BaseDevice::aquisition_thread_proc()
 
 	aquisition_state_ = AquisitionState::Running;
 	/*
-	// TODO: use std::chrono / std::time
 	// NOTE: ATM only the session start timestamp is used!
-	aquisition_start_timestamp_ =
-		QDateTime::currentMSecsSinceEpoch() / (double)1000;
+	aquisition_start_timestamp_ = SessionClock::now();
 	Q_EMIT aquisition_start_timestamp_changed(aquisition_start_timestamp_);
 	*/
 
@@ -21,17 +21,22 @@
 #ifndef DEVICES_BASEDEVICE_HPP
 #define DEVICES_BASEDEVICE_HPP
 
+#include <atomic>
+#include <condition_variable>
 #include <map>
 #include <memory>
 #include <mutex>
 #include <string>
 #include <thread>
+#include <vector>
 
 #include <QObject>
 #include <QString>
 
 #include "src/devices/deviceutil.hpp"
+#include "src/devices/ingestqueue.hpp"
 
+using std::atomic;
 using std::map;
 using std::mutex;
 using std::recursive_mutex;
@@ -66,6 +71,7 @@ class BaseSignal;
 
 namespace devices {
 
+class ConfigQueue;
 class Configurable;
 
 enum class AquisitionState {
@@ -74,6 +80,49 @@ enum class AquisitionState {
 	Paused
 };
 
+enum class AcquisitionHealth {
+	/** No packet has been received yet. */
+	Idle,
+	/** The packets are processed without delay. */
+	Ok,
+	/** Packets have been dropped recently or the ingest queue is filling. */
+	Lagging
+};
+
+/**
+ * Snapshot of the acquisition statistics of a device. The rates and the
+ * processing times are measured over the last statistics interval.
+ */
+struct acquisition_statistics_t
+{
+	uint64_t packet_count;
+	/** Number of samples per channel */
+	uint64_t sample_count;
+	/** Packets per second */
+	double packet_rate;
+	/** Samples per second and channel */
+	double sample_rate;
+	/** Average and max. time in µs to hand a packet over to the ingest queue */
+	double feed_in_time_avg;
+	double feed_in_time_max;
+	/** Average and max. time in µs to store a packet in the signals */
+	double ingest_time_avg;
+	double ingest_time_max;
+	size_t queue_depth;
+	size_t queue_capacity;
+	uint64_t dropped_packet_count;
+	uint64_t dropped_sample_count;
+	/** Dropped samples per second and channel */
+	double dropped_sample_rate;
+	/** Time in s since the last packet, -1 if no packet has been received */
+	double time_since_last_packet;
+	/** Round trip latency in ms of the last and the slowest config set,
+	    -1 if no config has been set */
+	double config_latency_last;
+	double config_latency_max;
+	size_t config_queue_depth;
+};
+
 class BaseDevice :
 	public QObject,
 	public std::enable_shared_from_this<BaseDevice>
@@ -131,7 +180,7 @@ public:
 	/**
 	 * Close the device.
 	 */
-	void close();
+	virtual void close();
 
 	/**
 	 * Start data aquisition from device after init or pause.
@@ -148,6 +197,15 @@ public:
 	 */
 	AquisitionState aquisition_state();
 
+	/**
+	 * Run the sigrok session of this device in its own acquisition thread,
+	 * even if a shared acquisition executor is available. Must be set
+	 * before the device is opened. Devices with serial or SCPI drivers are
+	 * isolated by default.
+	 */
+	void set_isolated_acquisition(bool isolated);
+	bool is_isolated_acquisition() const;
+
 	/**
 	 * Get the next index for a new channel.
 	 */
@@ -202,6 +260,44 @@ public:
 	 */
 	vector<shared_ptr<data::BaseSignal>> signals() const;
 
+	/**
+	 * Return the number of analog packets, that have been dropped because
+	 * the ingest queue was full.
+	 */
+	uint64_t dropped_packet_count() const;
+
+	/**
+	 * Return the number of samples (per channel) in the dropped packets.
+	 */
+	uint64_t dropped_sample_count() const;
+
+	/**
+	 * Return the acquisition statistics of the device. The counters are
+	 * updated with relaxed atomics in the datafeed and ingest threads, the
+	 * rates are calculated here.
+	 */
+	acquisition_statistics_t acquisition_statistics() const;
+
+	/**
+	 * Return the acquisition health, derived from the statistics.
+	 */
+	AcquisitionHealth acquisition_health() const;
+
+	/**
+	 * Set the latency offset of the device. The offset is subtracted from
+	 * the timestamps of all received packets, to compensate the delay
+	 * between the measurement and the arrival of the packet. This is used
+	 * to align the signals of multiple devices.
+	 *
+	 * @param latency_offset The latency offset in seconds.
+	 */
+	void set_latency_offset(double latency_offset);
+
+	/**
+	 * Return the latency offset of the device in seconds.
+	 */
+	double latency_offset() const;
+
 
 protected:
 	/**
@@ -225,6 +321,36 @@ protected:
 	virtual void feed_in_frame_end() = 0;
 	virtual void feed_in_logic(shared_ptr<sigrok::Logic> sr_logic) = 0;
 	virtual void feed_in_analog(shared_ptr<sigrok::Analog> sr_analog) = 0;
+	/**
+	 * Store an analog packet from the ingest queue in the hardware channels
+	 * of the device. This is called by the ingest thread with the data mutex
+	 * locked.
+	 */
+	virtual void ingest_analog(const analog_packet_t &packet);
+
+	/**
+	 * Copy a sigrok analog packet into the ingest queue. The samples are
+	 * stored in the channels by the ingest thread. This keeps the sigrok
+	 * session thread from blocking on the data mutex.
+	 *
+	 * @param timestamps Optional timestamps of the individual samples, for
+	 *        packets with irregularly spaced samples.
+	 */
+	void push_analog_packet(shared_ptr<sigrok::Analog> sr_analog,
+		double timestamp, uint64_t samplerate, int digits,
+		const vector<double> *timestamps = nullptr);
+
+	/**
+	 * Wake up the ingest thread after a packet has been pushed to the
+	 * ingest queue.
+	 */
+	void notify_ingest();
+
+	/**
+	 * Start the ingest thread. Called by init_acquisition().
+	 */
+	void start_ingest();
+	void stop_ingest();
 
 	void data_feed_in(shared_ptr<sigrok::Device> sr_device,
 		shared_ptr<sigrok::Packet> sr_packet);
@@ -242,6 +368,8 @@ protected:
 	unsigned int next_configurable_index_;
 
 	map<string, shared_ptr<devices::Configurable>> configurable_map_;
+	/** Executes the config calls of all configurables of the device. */
+	shared_ptr<ConfigQueue> config_queue_;
 	map<string, shared_ptr<channels::BaseChannel>> channel_map_;
 	map<string, vector<shared_ptr<channels::BaseChannel>>> channel_group_map_;
 	map<shared_ptr<sigrok::Channel>, shared_ptr<channels::BaseChannel>> sr_channel_map_;
@@ -253,10 +381,65 @@ protected:
 
 	bool frame_began_;
 
+	/**
+	 * Analog packets from the sigrok datafeed callback, that are stored in
+	 * the channels by the ingest thread.
+	 */
+	IngestQueue ingest_queue_;
+	/**
+	 * The ingest queue is full and packets are dropped. Only used by the
+	 * producer in push_analog_packet(), to warn once per overflow.
+	 */
+	bool is_ingest_overflow_;
+	/** Dropped packets at the start of the current overflow. */
+	uint64_t ingest_overflow_dropped_;
+
 private:
+	/**
+	 * The statistics counters at the start of a statistics interval.
+	 */
+	struct statistics_window_t
+	{
+		int64_t time;
+		uint64_t packet_count;
+		uint64_t sample_count;
+		uint64_t feed_in_time;
+		uint64_t ingest_count;
+		uint64_t ingest_time;
+		uint64_t dropped_samples;
+	};
+
 	void aquisition_thread_proc();
+	void ingest_thread_proc();
+	void on_session_stopped();
+	statistics_window_t current_statistics_window() const;
 
 	std::thread aquisition_thread_;
+	bool is_isolated_acquisition_;
+	/** The session runs on the shared acquisition executor */
+	bool is_shared_acquisition_;
+	bool is_session_stopped_;
+	mutex session_stopped_mutex_;
+	std::condition_variable session_stopped_cv_;
+	std::thread ingest_thread_;
+	atomic<bool> ingest_running_;
+	atomic<double> latency_offset_;
+	mutex ingest_mutex_;
+	std::condition_variable ingest_cv_;
+
+	/** Statistics counters, times in ns */
+	atomic<uint64_t> stat_packet_count_;
+	atomic<uint64_t> stat_sample_count_;
+	atomic<uint64_t> stat_feed_in_time_;
+	atomic<uint64_t> stat_feed_in_time_max_;
+	atomic<uint64_t> stat_ingest_count_;
+	atomic<uint64_t> stat_ingest_time_;
+	atomic<uint64_t> stat_ingest_time_max_;
+	/** Steady clock time in ns of the last packet, 0 if none */
+	atomic<int64_t> stat_last_packet_time_;
+	mutable mutex stat_mutex_;
+	mutable statistics_window_t stat_window_;
+	mutable acquisition_statistics_t stat_rates_;
 
 Q_SIGNALS:
 	void aquisition_start_timestamp_changed(double timestamp);
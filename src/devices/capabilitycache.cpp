@@ -0,0 +1,169 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2020 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <map>
+#include <string>
+
+#include <glib.h>
+#include <glibmm.h>
+
+#include <QDebug>
+#include <QSettings>
+#include <QString>
+#include <QStringList>
+
+#include "capabilitycache.hpp"
+#include "src/devices/deviceutil.hpp"
+
+using std::map;
+using std::string;
+
+/** Increase, when the format of the cache entries changes. */
+#define CAPABILITY_CACHE_VERSION 1
+
+namespace sv {
+namespace devices {
+
+CapabilityCache::CapabilityCache(const string &driver, const string &vendor,
+		const string &model, const string &version)
+{
+	QStringList parts;
+	parts << QString::fromStdString(driver) << QString::fromStdString(vendor)
+		<< QString::fromStdString(model) << QString::fromStdString(version);
+	device_key_ = parts.join("|");
+	// Slashes would create sub groups in the settings.
+	device_key_.replace('/', '_').replace('\\', '_');
+}
+
+bool CapabilityCache::get_capabilities(const string &configurable,
+	map<devices::ConfigKey, int> &capabilities) const
+{
+	QSettings settings;
+	settings.beginGroup(group_name(configurable));
+	if (!settings.value("complete", false).toBool())
+		return false;
+
+	capabilities.clear();
+	settings.beginGroup("capabilities");
+	for (const auto &key : settings.childKeys()) {
+		devices::ConfigKey config_key =
+			devices::deviceutil::get_config_key(key.toUInt());
+		if (config_key == devices::ConfigKey::Unknown)
+			continue;
+		capabilities[config_key] = settings.value(key).toInt();
+	}
+	settings.endGroup();
+
+	return true;
+}
+
+void CapabilityCache::set_capabilities(const string &configurable,
+	const map<devices::ConfigKey, int> &capabilities)
+{
+	QSettings settings;
+	settings.beginGroup(group_name(configurable));
+	settings.remove("");
+	settings.beginGroup("capabilities");
+	for (const auto &entry : capabilities) {
+		settings.setValue(QString::number(
+			devices::deviceutil::get_sr_config_key_id(entry.first)),
+			entry.second);
+	}
+	settings.endGroup();
+	settings.setValue("complete", true);
+}
+
+bool CapabilityCache::get_list(const string &configurable,
+	devices::ConfigKey config_key, Glib::VariantContainerBase &gvar) const
+{
+	if (is_volatile_list(config_key))
+		return false;
+
+	QSettings settings;
+	settings.beginGroup(group_name(configurable));
+	const QString key = QString("lists/%1").arg(
+		devices::deviceutil::get_sr_config_key_id(config_key));
+	if (!settings.contains(key))
+		return false;
+
+	const QByteArray text = settings.value(key).toString().toUtf8();
+	GError *error = nullptr;
+	GVariant *gvariant = g_variant_parse(
+		nullptr, text.constData(), nullptr, nullptr, &error);
+	if (!gvariant) {
+		qWarning() << "CapabilityCache::get_list(): Invalid entry for " <<
+			devices::deviceutil::format_config_key(config_key) << ": " <<
+			error->message;
+		g_error_free(error);
+		return false;
+	}
+	if (!g_variant_is_container(gvariant)) {
+		g_variant_unref(gvariant);
+		return false;
+	}
+
+	// g_variant_parse() returns a non-floating reference, that is taken over.
+	gvar = Glib::VariantContainerBase(gvariant);
+	return true;
+}
+
+void CapabilityCache::set_list(const string &configurable,
+	devices::ConfigKey config_key, const Glib::VariantContainerBase &gvar)
+{
+	if (is_volatile_list(config_key) || !gvar.gobj())
+		return;
+
+	// Print with type annotations, so the entry parses to the same type.
+	gchar *text = g_variant_print(const_cast<GVariant *>(gvar.gobj()), TRUE);
+
+	QSettings settings;
+	settings.beginGroup(group_name(configurable));
+	settings.setValue(QString("lists/%1").arg(
+		devices::deviceutil::get_sr_config_key_id(config_key)),
+		QString::fromUtf8(text));
+
+	g_free(text);
+}
+
+bool CapabilityCache::is_volatile_list(devices::ConfigKey config_key)
+{
+	switch (config_key) {
+	case devices::ConfigKey::Range:
+	case devices::ConfigKey::VoltageTarget:
+	case devices::ConfigKey::CurrentLimit:
+		return true;
+	default:
+		return false;
+	}
+}
+
+QString CapabilityCache::group_name(const string &configurable) const
+{
+	QString name = QString::fromStdString(configurable);
+	if (name.isEmpty())
+		name = "device";
+	name.replace('/', '_').replace('\\', '_');
+
+	return QString("CapabilityCache/v%1/%2/%3").
+		arg(CAPABILITY_CACHE_VERSION).arg(device_key_).arg(name);
+}
+
+} // namespace devices
+} // namespace sv
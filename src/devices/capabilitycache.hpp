@@ -0,0 +1,96 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2020 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef DEVICES_CAPABILITYCACHE_HPP
+#define DEVICES_CAPABILITYCACHE_HPP
+
+#include <map>
+#include <string>
+
+#include <glibmm.h>
+
+#include <QString>
+
+#include "src/devices/deviceutil.hpp"
+
+using std::map;
+using std::string;
+
+namespace sv {
+namespace devices {
+
+/**
+ * Capabilities of a config key, as bit flags.
+ */
+enum ConfigCapability {
+	CapabilityGet = 1,
+	CapabilitySet = 2,
+	CapabilityList = 4
+};
+
+/**
+ * Persistent cache of the config capabilities and list results of a device
+ * model. The entries are stored in the application settings and are keyed by
+ * driver, vendor, model and firmware version, so reconnecting a known
+ * instrument doesn't have to query them again.
+ */
+class CapabilityCache
+{
+
+public:
+	CapabilityCache(const string &driver, const string &vendor,
+		const string &model, const string &version);
+
+	/**
+	 * Get the capabilities of all config keys of a configurable (channel
+	 * group). Returns false, if the configurable isn't cached yet.
+	 */
+	bool get_capabilities(const string &configurable,
+		map<devices::ConfigKey, int> &capabilities) const;
+	void set_capabilities(const string &configurable,
+		const map<devices::ConfigKey, int> &capabilities);
+
+	/**
+	 * Get the list result of a config key. Returns false, if the list isn't
+	 * cached yet.
+	 */
+	bool get_list(const string &configurable, devices::ConfigKey config_key,
+		Glib::VariantContainerBase &gvar) const;
+	void set_list(const string &configurable, devices::ConfigKey config_key,
+		const Glib::VariantContainerBase &gvar);
+
+	/**
+	 * Check if the list of a config key depends on the value of another
+	 * config key (e.g. the ranges depend on the measured quantity). Those
+	 * lists are never cached.
+	 */
+	static bool is_volatile_list(devices::ConfigKey config_key);
+
+private:
+	QString group_name(const string &configurable) const;
+
+	QString device_key_;
+
+};
+
+} // namespace devices
+} // namespace sv
+
+#endif // DEVICES_CAPABILITYCACHE_HPP
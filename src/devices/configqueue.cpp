@@ -0,0 +1,188 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2020 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "configqueue.hpp"
+
+using std::lock_guard;
+using std::make_shared;
+using std::packaged_task;
+using std::unique_lock;
+
+namespace sv {
+namespace devices {
+
+ConfigQueue::ConfigQueue() :
+	coalesced_count_(0),
+	last_latency_(-1),
+	max_latency_(-1),
+	running_(true)
+{
+	queue_thread_ = std::thread(&ConfigQueue::queue_thread_proc, this);
+}
+
+ConfigQueue::~ConfigQueue()
+{
+	stop();
+}
+
+void ConfigQueue::push_set(config_command_key_t key, function<void()> command)
+{
+	{
+		lock_guard<mutex> lock(mutex_);
+		if (running_) {
+			const auto it = pending_sets_.find(key);
+			if (it != pending_sets_.end()) {
+				it->second->command = command;
+				++coalesced_count_;
+			}
+			else {
+				commands_.push_back({ true, key, command });
+				pending_sets_[key] = --commands_.end();
+			}
+			cv_.notify_one();
+			return;
+		}
+	}
+
+	command();
+}
+
+void ConfigQueue::run(function<void()> command)
+{
+	// Called from within a command, waiting would dead lock.
+	if (std::this_thread::get_id() == queue_thread_.get_id()) {
+		command();
+		return;
+	}
+
+	auto task = make_shared<packaged_task<void()>>(command);
+	auto result = task->get_future();
+	bool queued = false;
+	{
+		lock_guard<mutex> lock(mutex_);
+		if (running_) {
+			commands_.push_back({ false, config_command_key_t(), [task]() {
+				(*task)();
+			}});
+			// Sets after this command must not be merged into earlier sets.
+			pending_sets_.clear();
+			cv_.notify_one();
+			queued = true;
+		}
+	}
+	if (!queued)
+		(*task)();
+	result.get();
+}
+
+uint64_t ConfigQueue::begin_set(config_command_key_t key)
+{
+	lock_guard<mutex> lock(mutex_);
+	return ++set_generations_[key];
+}
+
+uint64_t ConfigQueue::set_generation(config_command_key_t key) const
+{
+	lock_guard<mutex> lock(mutex_);
+	const auto it = set_generations_.find(key);
+	if (it == set_generations_.end())
+		return 0;
+	return it->second;
+}
+
+void ConfigQueue::stop()
+{
+	{
+		lock_guard<mutex> lock(mutex_);
+		if (!running_)
+			return;
+		running_ = false;
+		cv_.notify_one();
+	}
+	if (queue_thread_.joinable())
+		queue_thread_.join();
+}
+
+size_t ConfigQueue::pending_count() const
+{
+	lock_guard<mutex> lock(mutex_);
+	return commands_.size();
+}
+
+uint64_t ConfigQueue::coalesced_count() const
+{
+	lock_guard<mutex> lock(mutex_);
+	return coalesced_count_;
+}
+
+void ConfigQueue::add_latency(double latency)
+{
+	lock_guard<mutex> lock(mutex_);
+	last_latency_ = latency;
+	if (latency > max_latency_)
+		max_latency_ = latency;
+}
+
+double ConfigQueue::last_latency() const
+{
+	lock_guard<mutex> lock(mutex_);
+	return last_latency_;
+}
+
+double ConfigQueue::max_latency() const
+{
+	lock_guard<mutex> lock(mutex_);
+	return max_latency_;
+}
+
+void ConfigQueue::queue_thread_proc()
+{
+	unique_lock<mutex> lock(mutex_);
+	while (true) {
+		if (commands_.empty()) {
+			// Drain the queue before stopping.
+			if (!running_)
+				break;
+			cv_.wait(lock);
+			continue;
+		}
+
+		command_t command = commands_.front();
+		if (command.is_set) {
+			const auto it = pending_sets_.find(command.key);
+			if (it != pending_sets_.end() && it->second == commands_.begin())
+				pending_sets_.erase(it);
+		}
+		commands_.pop_front();
+
+		lock.unlock();
+		command.command();
+		lock.lock();
+	}
+}
+
+} // namespace devices
+} // namespace sv
@@ -0,0 +1,163 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2020 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef DEVICES_CONFIGQUEUE_HPP
+#define DEVICES_CONFIGQUEUE_HPP
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+#include "src/devices/deviceutil.hpp"
+
+using std::function;
+using std::list;
+using std::map;
+using std::mutex;
+using std::pair;
+
+namespace sv {
+namespace devices {
+
+class Configurable;
+
+/**
+ * Key of a coalescable command: The configurable and the config key.
+ */
+typedef pair<const Configurable *, devices::ConfigKey> config_command_key_t;
+
+/**
+ * Command queue of a device, that executes all config calls to the device
+ * on its own thread.
+ *
+ * Set commands for the same configurable and config key, that are still
+ * waiting in the queue, are replaced by the newer command (last value wins),
+ * so e.g. dragging a knob doesn't flood a slow device with intermediate
+ * values. Commands that are executed synchronously (the gets) act as a
+ * barrier: A set that is queued after a get is never merged into a set that
+ * was queued before the get.
+ *
+ * Every set increments the set generation of its key. A read, that has been
+ * issued at an older generation, must not overwrite the value of the newer
+ * set, that is still waiting in the queue.
+ */
+class ConfigQueue
+{
+
+public:
+	ConfigQueue();
+	~ConfigQueue();
+
+	/**
+	 * Queue a set command and return immediately. A waiting command with
+	 * the same key is replaced by this command, but keeps its position in
+	 * the queue.
+	 */
+	void push_set(config_command_key_t key, function<void()> command);
+
+	/**
+	 * Queue a command and wait until it has been executed. Exceptions of the
+	 * command are rethrown in the calling thread.
+	 */
+	void run(function<void()> command);
+
+	/**
+	 * Increment the set generation of the key. Must be called when a new
+	 * value for the key is set, before the set command is queued.
+	 *
+	 * @return The new set generation of the key.
+	 */
+	uint64_t begin_set(config_command_key_t key);
+
+	/**
+	 * Return the set generation of the key, 0 if it has never been set.
+	 */
+	uint64_t set_generation(config_command_key_t key) const;
+
+	/**
+	 * Execute the remaining commands and stop the queue thread. Commands
+	 * pushed afterwards are executed in the calling thread.
+	 */
+	void stop();
+
+	/**
+	 * Return the number of commands waiting in the queue.
+	 */
+	size_t pending_count() const;
+
+	/**
+	 * Return the number of set commands, that have been replaced by a newer
+	 * command for the same key.
+	 */
+	uint64_t coalesced_count() const;
+
+	/**
+	 * Record the latency of an executed set command, from queueing until the
+	 * device has accepted the value.
+	 *
+	 * @param latency The latency in ms.
+	 */
+	void add_latency(double latency);
+
+	/**
+	 * Return the latency of the last set command in ms or -1 if no command
+	 * has been executed yet.
+	 */
+	double last_latency() const;
+
+	/**
+	 * Return the maximum latency of all set commands in ms or -1 if no
+	 * command has been executed yet.
+	 */
+	double max_latency() const;
+
+private:
+	struct command_t
+	{
+		bool is_set;
+		config_command_key_t key;
+		function<void()> command;
+	};
+
+	void queue_thread_proc();
+
+	list<command_t> commands_;
+	/** Waiting set commands, that newer sets can be merged into. */
+	map<config_command_key_t, list<command_t>::iterator> pending_sets_;
+	map<config_command_key_t, uint64_t> set_generations_;
+	uint64_t coalesced_count_;
+	double last_latency_;
+	double max_latency_;
+	bool running_;
+	std::thread queue_thread_;
+	mutable mutex mutex_;
+	std::condition_variable cv_;
+
+};
+
+} // namespace devices
+} // namespace sv
+
+#endif // DEVICES_CONFIGQUEUE_HPP
@@ -17,13 +17,17 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
 #include <cassert>
+#include <chrono>
 #include <tuple>
 #include <type_traits>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include <glibmm.h>
 
@@ -33,6 +37,8 @@
 #include <QString>
 
 #include "configurable.hpp"
+#include "src/devices/capabilitycache.hpp"
+#include "src/devices/configqueue.hpp"
 #include "src/data/datautil.hpp"
 #include "src/data/properties/baseproperty.hpp"
 #include "src/data/properties/boolproperty.hpp"
@@ -46,23 +52,53 @@
 #include "src/data/properties/uint64rangeproperty.hpp"
 
 using std::dynamic_pointer_cast;
+using std::lock_guard;
 using std::make_pair;
 using std::make_shared;
 using std::string;
+using std::unique_lock;
+using std::vector;
 using sv::devices::ConfigKey;
 
 namespace sv {
 namespace devices {
 
+namespace {
+
+/**
+ * Status keys, that can change on the device side without a meta packet, are
+ * polled in the background by default (interval in ms).
+ */
+const map<ConfigKey, int> default_poll_intervals = {
+	{ ConfigKey::OverVoltageProtectionActive, 1000 },
+	{ ConfigKey::OverCurrentProtectionActive, 1000 },
+	{ ConfigKey::OverTemperatureProtectionActive, 1000 },
+	{ ConfigKey::UnderVoltageConditionActive, 1000 },
+	{ ConfigKey::Regulation, 1000 },
+};
+
+}
+
 Configurable::Configurable(
 		const shared_ptr<sigrok::Configurable> sr_configurable,
 		unsigned int configurable_index,
-		const string device_name, const DeviceType device_type):
+		const string device_name, const DeviceType device_type,
+		shared_ptr<ConfigQueue> config_queue,
+		shared_ptr<CapabilityCache> capability_cache):
 	sr_configurable_(sr_configurable),
 	configurable_index_(configurable_index),
 	device_name_(device_name),
-	device_type_(device_type)
+	device_type_(device_type),
+	config_queue_(config_queue),
+	capability_cache_(capability_cache),
+	poll_running_(false)
 {
+	assert(config_queue_);
+}
+
+Configurable::~Configurable()
+{
+	stop_polling();
 }
 
 /*
@@ -83,77 +119,120 @@ shared_ptr<Configurable> Configurable::create(Arg&&...arg)
 
 void Configurable::init()
 {
-	const auto sr_config_keys = sr_configurable_->config_keys();
-	for (const auto &sr_config_key : sr_config_keys) {
-		ConfigKey config_key = deviceutil::get_config_key(sr_config_key);
-		if (config_key == ConfigKey::Unknown)
-			continue;
+	// Config keys and capabilities of known device models are read from the
+	// capability cache.
+	map<ConfigKey, int> capabilities;
+	if (!capability_cache_ ||
+			!capability_cache_->get_capabilities(name(), capabilities)) {
+		const auto sr_config_keys = sr_configurable_->config_keys();
+		for (const auto &sr_config_key : sr_config_keys) {
+			ConfigKey config_key = deviceutil::get_config_key(sr_config_key);
+			if (config_key == ConfigKey::Unknown)
+				continue;
+
+			int caps = 0;
+			const auto sr_capabilities =
+				sr_configurable_->config_capabilities(sr_config_key);
+			if (sr_capabilities.count(sigrok::Capability::GET))
+				caps |= CapabilityGet;
+			if (sr_capabilities.count(sigrok::Capability::SET))
+				caps |= CapabilitySet;
+			if (sr_capabilities.count(sigrok::Capability::LIST))
+				caps |= CapabilityList;
+			capabilities[config_key] = caps;
+		}
 
+		if (capability_cache_)
+			capability_cache_->set_capabilities(name(), capabilities);
+	}
+
+	for (const auto &entry : capabilities) {
+		ConfigKey config_key = entry.first;
 		qWarning() << "Configurable::init(): Init " << display_name() <<
 			" - key " << deviceutil::format_config_key(config_key);
 
-		const auto sr_capabilities =
-			sr_configurable_->config_capabilities(sr_config_key);
-		if (sr_capabilities.count(sigrok::Capability::GET))
+		config_keys_.insert(config_key);
+		if (entry.second & CapabilityGet)
 			getable_configs_.insert(config_key);
-		if (sr_capabilities.count(sigrok::Capability::SET))
+		if (entry.second & CapabilitySet)
 			setable_configs_.insert(config_key);
-		if (sr_capabilities.count(sigrok::Capability::LIST))
+		if (entry.second & CapabilityList)
 			listable_configs_.insert(config_key);
+	}
 
-		shared_ptr<data::properties::BaseProperty> property;
-		const data::DataType data_type =
-			deviceutil::get_data_type_for_config_key(config_key);
-		switch (data_type) {
-		case data::DataType::Int32:
-			property = make_shared<data::properties::Int32Property>(
-				shared_from_this(), config_key);
-			break;
-		case data::DataType::UInt64:
-			property = make_shared<data::properties::UInt64Property>(
-				shared_from_this(), config_key);
-			break;
-		case data::DataType::Double:
-			property = make_shared<data::properties::DoubleProperty>(
-				shared_from_this(), config_key);
-			break;
-		case data::DataType::String:
-			property = make_shared<data::properties::StringProperty>(
-				shared_from_this(), config_key);
-			break;
-		case data::DataType::Bool:
-			property = make_shared<data::properties::BoolProperty>(
-				shared_from_this(), config_key);
-			break;
-		case data::DataType::MQ:
-			property = make_shared<data::properties::MeasuredQuantityProperty>(
-				shared_from_this(), config_key);
-			break;
-		case data::DataType::RationalPeriod:
-			property = make_shared<data::properties::RationalProperty>(
-				shared_from_this(), config_key);
-			break;
-		case data::DataType::RationalVolt:
-			property = make_shared<data::properties::RationalProperty>(
-				shared_from_this(), config_key);
-			break;
-		case data::DataType::Uint64Range:
-			property = make_shared<data::properties::UInt64RangeProperty>(
-				shared_from_this(), config_key);
-			break;
-		case data::DataType::DoubleRange:
-			property = make_shared<data::properties::DoubleRangeProperty>(
-				shared_from_this(), config_key);
-			break;
-		case data::DataType::KeyValue:
-			// TODO: What is KeyValue?
-		case data::DataType::Unknown:
-		default:
-			assert("Unknown DataType");
-		}
+	// The properties are created on first use, see get_property().
+
+	for (const auto &entry : default_poll_intervals) {
+		if (has_get_config(entry.first))
+			set_poll_interval(entry.first, entry.second);
+	}
+}
 
-		properties_.insert(make_pair(config_key, property));
+shared_ptr<data::properties::BaseProperty>
+	Configurable::create_property(devices::ConfigKey config_key)
+{
+	shared_ptr<data::properties::BaseProperty> property;
+	const data::DataType data_type =
+		deviceutil::get_data_type_for_config_key(config_key);
+	switch (data_type) {
+	case data::DataType::Int32:
+		property = make_shared<data::properties::Int32Property>(
+			shared_from_this(), config_key);
+		break;
+	case data::DataType::UInt64:
+		property = make_shared<data::properties::UInt64Property>(
+			shared_from_this(), config_key);
+		break;
+	case data::DataType::Double:
+		property = make_shared<data::properties::DoubleProperty>(
+			shared_from_this(), config_key);
+		break;
+	case data::DataType::String:
+		property = make_shared<data::properties::StringProperty>(
+			shared_from_this(), config_key);
+		break;
+	case data::DataType::Bool:
+		property = make_shared<data::properties::BoolProperty>(
+			shared_from_this(), config_key);
+		break;
+	case data::DataType::MQ:
+		property = make_shared<data::properties::MeasuredQuantityProperty>(
+			shared_from_this(), config_key);
+		break;
+	case data::DataType::RationalPeriod:
+		property = make_shared<data::properties::RationalProperty>(
+			shared_from_this(), config_key);
+		break;
+	case data::DataType::RationalVolt:
+		property = make_shared<data::properties::RationalProperty>(
+			shared_from_this(), config_key);
+		break;
+	case data::DataType::Uint64Range:
+		property = make_shared<data::properties::UInt64RangeProperty>(
+			shared_from_this(), config_key);
+		break;
+	case data::DataType::DoubleRange:
+		property = make_shared<data::properties::DoubleRangeProperty>(
+			shared_from_this(), config_key);
+		break;
+	case data::DataType::KeyValue:
+		// TODO: What is KeyValue?
+	case data::DataType::Unknown:
+	default:
+		assert("Unknown DataType");
 	}
+
+	return property;
+}
+
+shared_ptr<data::properties::BaseProperty>
+	Configurable::existing_property(devices::ConfigKey config_key) const
+{
+	lock_guard<mutex> lock(properties_mutex_);
+	const auto it = properties_.find(config_key);
+	if (it == properties_.end())
+		return nullptr;
+	return it->second;
 }
 
 bool Configurable::has_get_config(devices::ConfigKey config_key)  const
@@ -168,71 +247,76 @@ template double Configurable::get_config(devices::ConfigKey) const;
 template std::string Configurable::get_config(devices::ConfigKey) const;
 template<typename T> T Configurable::get_config(devices::ConfigKey config_key) const
 {
-	assert(sr_configurable_);
-
-	const sigrok::ConfigKey *sr_key =
-		devices::deviceutil::get_sr_config_key(config_key);
+	return Glib::VariantBase::cast_dynamic<Glib::Variant<T>>(
+		get_cached_config(config_key)).get();
+}
 
-	if (!sr_configurable_->config_check(sr_key, sigrok::Capability::GET)) {
-		qWarning() << "Configurable::get_config(): No getable config key " <<
-			devices::deviceutil::format_config_key(config_key);
-		assert(false);
+Glib::VariantContainerBase Configurable::get_container_config(
+	devices::ConfigKey config_key) const
+{
+	Glib::VariantBase gvar = get_cached_config(config_key);
+	if (gvar.is_container()) {
+		Glib::VariantContainerBase gcontainer =
+			Glib::VariantBase::cast_dynamic<Glib::VariantContainerBase>(gvar);
+		return gcontainer;
 	}
+	return Glib::VariantContainerBase();
+}
 
-	// TODO: implement like get_list
-	/*
-	try {
-	*/
-		return Glib::VariantBase::cast_dynamic<Glib::Variant<T>>(
-			sr_configurable_->config_get(sr_key)).get();
-	/*
-	}
-	catch (sigrok::Error &error) {
-		qWarning() << "Configurable::list_config(): Failed to get key " <<
-			devices::deviceutil::format_config_key(key) << ". " << error.what();
-		assert(false);
+Glib::VariantBase Configurable::get_cached_config(
+	devices::ConfigKey config_key) const
+{
+	{
+		lock_guard<mutex> lock(cache_mutex_);
+		const auto it = value_cache_.find(config_key);
+		if (it != value_cache_.end())
+			return it->second;
 	}
 
-	return ;
-	*/
+	const uint64_t set_generation =
+		config_queue_->set_generation(make_pair(this, config_key));
+	Glib::VariantBase gvar = read_config(config_key);
+	update_cached_config(config_key, gvar, set_generation);
+	return gvar;
 }
 
-Glib::VariantContainerBase Configurable::get_container_config(
-	devices::ConfigKey config_key) const
+Glib::VariantBase Configurable::read_config(devices::ConfigKey config_key) const
 {
 	assert(sr_configurable_);
 
 	const sigrok::ConfigKey *sr_key =
 		devices::deviceutil::get_sr_config_key(config_key);
 
-	if (!sr_configurable_->config_check(sr_key, sigrok::Capability::GET)) {
-		qWarning() <<
-			"Configurable::get_container_config(): No getable config key " <<
+	if (!has_get_config(config_key)) {
+		qWarning() << "Configurable::read_config(): No getable config key " <<
 			devices::deviceutil::format_config_key(config_key);
 		assert(false);
 	}
 
-	// TODO: implement like get_list
-	/*
-	try {
-	*/
-	Glib::VariantBase gvar = sr_configurable_->config_get(sr_key);
-	if (gvar.is_container()) {
-		Glib::VariantContainerBase gcontainer =
-			Glib::VariantBase::cast_dynamic<Glib::VariantContainerBase>(gvar);
-		return gcontainer;
-	}
-	return Glib::VariantContainerBase();
-	/*
-	}
-	catch (sigrok::Error &error) {
-		qWarning() << "Configurable::list_config(): Failed to get key " <<
-			devices::deviceutil::format_config_key(key) << ". " << error.what();
-		assert(false);
-	}
+	// Gets are queued like the sets, so they see all previously set values.
+	Glib::VariantBase gvar;
+	config_queue_->run([this, sr_key, &gvar]() {
+		lock_guard<mutex> lock(sr_mutex_);
+		gvar = sr_configurable_->config_get(sr_key);
+	});
+	return gvar;
+}
+
+bool Configurable::update_cached_config(devices::ConfigKey config_key,
+	Glib::VariantBase gvar, uint64_t set_generation) const
+{
+	lock_guard<mutex> lock(cache_mutex_);
+	// The cache already holds the value of a newer set, that is still
+	// waiting in the queue.
+	if (config_queue_->set_generation(make_pair(this, config_key)) !=
+			set_generation)
+		return false;
 
-	return ;
-	*/
+	const auto it = value_cache_.find(config_key);
+	const bool changed = it == value_cache_.end() || !it->second.gobj() ||
+		!gvar.equal(it->second);
+	value_cache_[config_key] = gvar;
+	return changed;
 }
 
 bool Configurable::has_set_config(devices::ConfigKey config_key) const
@@ -249,52 +333,90 @@ template void Configurable::set_config(devices::ConfigKey, const Glib::ustring);
 template<typename T> void Configurable::set_config(
 	devices::ConfigKey config_key, const T value)
 {
-	assert(sr_configurable_);
-
-	const sigrok::ConfigKey *sr_key =
-		devices::deviceutil::get_sr_config_key(config_key);
-
-	if (!sr_configurable_->config_check(sr_key, sigrok::Capability::SET)) {
-		qWarning() << "Configurable::set_config(): No setable config key " <<
-			devices::deviceutil::format_config_key(config_key);
-		assert(false);
-	}
+	set_variant_config(config_key, Glib::Variant<T>::create(value), true);
+}
 
-	try {
-		sr_configurable_->config_set(sr_key, Glib::Variant<T>::create(value));
-	}
-	catch (sigrok::Error &error) {
-		qWarning() << "Configurable::set_config(): Failed to set config key " <<
-			devices::deviceutil::format_config_key(config_key) << ". " <<
-			error.what();
-	}
+template void Configurable::queue_set_config(devices::ConfigKey, const bool);
+template void Configurable::queue_set_config(devices::ConfigKey, const int32_t);
+template void Configurable::queue_set_config(devices::ConfigKey, const uint64_t);
+template void Configurable::queue_set_config(devices::ConfigKey, const double);
+template void Configurable::queue_set_config(devices::ConfigKey, const std::string);
+template void Configurable::queue_set_config(devices::ConfigKey, const Glib::ustring);
+template<typename T> void Configurable::queue_set_config(
+	devices::ConfigKey config_key, const T value)
+{
+	set_variant_config(config_key, Glib::Variant<T>::create(value), false);
 }
 
 void Configurable::set_container_config(
 	devices::ConfigKey config_key, vector<Glib::VariantBase> childs)
+{
+	set_variant_config(config_key,
+		Glib::VariantContainerBase::create_tuple(childs), true);
+}
+
+void Configurable::queue_set_container_config(
+	devices::ConfigKey config_key, vector<Glib::VariantBase> childs)
+{
+	set_variant_config(config_key,
+		Glib::VariantContainerBase::create_tuple(childs), false);
+}
+
+void Configurable::set_variant_config(devices::ConfigKey config_key,
+	Glib::VariantBase gvar, bool wait)
 {
 	assert(sr_configurable_);
 
 	const sigrok::ConfigKey *sr_key =
 		devices::deviceutil::get_sr_config_key(config_key);
 
-	if (!sr_configurable_->config_check(sr_key, sigrok::Capability::SET)) {
-		qWarning() <<
-			"Configurable::set_container_config(): No setable config key " <<
+	if (!has_set_config(config_key)) {
+		qWarning() << "Configurable::set_config(): No setable config key " <<
 			devices::deviceutil::format_config_key(config_key);
 		assert(false);
 	}
 
-	try {
-		sr_configurable_->config_set(
-			sr_key, Glib::VariantContainerBase::create_tuple(childs));
-	}
-	catch (sigrok::Error &error) {
-		qWarning() <<
-			"Configurable::set_container_config(): Failed to set config key " <<
-			devices::deviceutil::format_config_key(config_key) << ". " <<
-			error.what();
+	// Reads of the property return the new value right away.
+	uint64_t set_generation;
+	{
+		lock_guard<mutex> lock(cache_mutex_);
+		set_generation = config_queue_->begin_set(make_pair(this, config_key));
+		value_cache_[config_key] = gvar;
 	}
+
+	auto self = shared_from_this();
+	const auto queued_time = std::chrono::steady_clock::now();
+	auto command = [self, config_key, sr_key, gvar, set_generation,
+			queued_time]() {
+		bool success = true;
+		try {
+			lock_guard<mutex> lock(self->sr_mutex_);
+			self->sr_configurable_->config_set(sr_key, gvar);
+		}
+		catch (sigrok::Error &error) {
+			qWarning() << "Configurable::set_config(): Failed to set config key " <<
+				devices::deviceutil::format_config_key(config_key) << ". " <<
+				error.what();
+			success = false;
+		}
+
+		// Restore the actual value of the device, unless a newer value
+		// has been set in the meantime.
+		if (!success)
+			self->refresh_config_at(config_key, set_generation);
+
+		const double latency = std::chrono::duration<double, std::milli>(
+			std::chrono::steady_clock::now() - queued_time).count();
+		self->config_queue_->add_latency(latency);
+		auto property = self->existing_property(config_key);
+		if (property)
+			Q_EMIT property->value_set(success, latency);
+	};
+
+	if (wait)
+		config_queue_->run(command);
+	else
+		config_queue_->push_set(make_pair(this, config_key), command);
 }
 
 bool Configurable::has_list_config(devices::ConfigKey config_key) const
@@ -310,14 +432,19 @@ bool Configurable::list_config(devices::ConfigKey config_key,
 	const sigrok::ConfigKey *sr_key =
 		devices::deviceutil::get_sr_config_key(config_key);
 
-	if (!sr_configurable_->config_check(sr_key, sigrok::Capability::LIST)) {
+	if (!has_list_config(config_key)) {
 		qWarning() <<
 			"Configurable::list_config(): No config key / no listable config key " <<
 			devices::deviceutil::format_config_key(config_key);
 		return false;
 	}
 
+	if (capability_cache_ &&
+			capability_cache_->get_list(name(), config_key, gvar))
+		return true;
+
 	try {
+		lock_guard<mutex> lock(sr_mutex_);
 		gvar = sr_configurable_->config_list(sr_key);
 	}
 	catch (sigrok::Error &error) {
@@ -326,6 +453,9 @@ bool Configurable::list_config(devices::ConfigKey config_key,
 		return false;
 	}
 
+	if (capability_cache_)
+		capability_cache_->set_list(name(), config_key, gvar);
+
 	return true;
 }
 
@@ -375,18 +505,49 @@ set<devices::ConfigKey> Configurable::listable_configs() const
 	return listable_configs_;
 }
 
+bool Configurable::has_property(devices::ConfigKey config_key) const
+{
+	return config_keys_.count(config_key) > 0;
+}
+
+set<devices::ConfigKey> Configurable::config_keys() const
+{
+	return config_keys_;
+}
+
 map<devices::ConfigKey, shared_ptr<data::properties::BaseProperty>>
-	Configurable::properties() const
+	Configurable::properties()
 {
+	for (const auto &config_key : config_keys_)
+		get_property(config_key);
+
+	lock_guard<mutex> lock(properties_mutex_);
 	return properties_;
 }
 
 shared_ptr<data::properties::BaseProperty>
-	Configurable::get_property(devices::ConfigKey config_key) const
+	Configurable::get_property(devices::ConfigKey config_key)
 {
-	if (!properties_.count(config_key))
+	if (!config_keys_.count(config_key))
 		return nullptr;
-	return properties_.at(config_key);
+
+	{
+		lock_guard<mutex> lock(properties_mutex_);
+		const auto it = properties_.find(config_key);
+		if (it != properties_.end())
+			return it->second;
+	}
+
+	/*
+	 * The property is created without holding the lock, because the ctor
+	 * may query the device through the config queue, whose thread notifies
+	 * the existing properties.
+	 */
+	auto property = create_property(config_key);
+
+	lock_guard<mutex> lock(properties_mutex_);
+	const auto it = properties_.insert(make_pair(config_key, property)).first;
+	return it->second;
 }
 
 bool Configurable::is_controllable() const
@@ -396,19 +557,126 @@ bool Configurable::is_controllable() const
 		!listable_configs_.empty();
 }
 
+bool Configurable::refresh_config(devices::ConfigKey config_key)
+{
+	return refresh_config_at(config_key,
+		config_queue_->set_generation(make_pair(this, config_key)));
+}
+
+bool Configurable::refresh_config_at(devices::ConfigKey config_key,
+	uint64_t set_generation)
+{
+	Glib::VariantBase gvar;
+	try {
+		gvar = read_config(config_key);
+	}
+	catch (sigrok::Error &error) {
+		qWarning() << "Configurable::refresh_config(): Failed to get config key " <<
+			devices::deviceutil::format_config_key(config_key) << ". " <<
+			error.what();
+		return false;
+	}
+
+	if (!update_cached_config(config_key, gvar, set_generation))
+		return true;
+	auto property = existing_property(config_key);
+	if (property)
+		property->on_value_changed(gvar);
+
+	return true;
+}
+
+void Configurable::set_poll_interval(devices::ConfigKey config_key,
+	int interval)
+{
+	{
+		lock_guard<mutex> lock(poll_mutex_);
+		if (interval > 0) {
+			poll_intervals_[config_key] = interval;
+			poll_next_[config_key] = std::chrono::steady_clock::now() +
+				std::chrono::milliseconds(interval);
+		}
+		else {
+			poll_intervals_.erase(config_key);
+			poll_next_.erase(config_key);
+		}
+
+		if (poll_running_ || poll_intervals_.empty()) {
+			poll_cv_.notify_one();
+			return;
+		}
+		poll_running_ = true;
+	}
+
+	// The poll thread is only started, when there is something to poll.
+	poll_thread_ = std::thread(&Configurable::poll_thread_proc, this);
+}
+
+int Configurable::poll_interval(devices::ConfigKey config_key) const
+{
+	lock_guard<mutex> lock(poll_mutex_);
+	const auto it = poll_intervals_.find(config_key);
+	if (it == poll_intervals_.end())
+		return 0;
+	return it->second;
+}
+
+void Configurable::stop_polling()
+{
+	{
+		lock_guard<mutex> lock(poll_mutex_);
+		poll_running_ = false;
+	}
+	poll_cv_.notify_one();
+	if (poll_thread_.joinable())
+		poll_thread_.join();
+}
+
+void Configurable::poll_thread_proc()
+{
+	unique_lock<mutex> lock(poll_mutex_);
+	while (poll_running_) {
+		const poll_time_t now = std::chrono::steady_clock::now();
+		poll_time_t next = now + std::chrono::seconds(1);
+		vector<ConfigKey> due_keys;
+		for (auto &entry : poll_next_) {
+			if (entry.second <= now) {
+				due_keys.push_back(entry.first);
+				entry.second = now +
+					std::chrono::milliseconds(poll_intervals_[entry.first]);
+			}
+			next = std::min(next, entry.second);
+		}
+
+		if (due_keys.empty()) {
+			poll_cv_.wait_until(lock, next);
+			continue;
+		}
+
+		// Don't block set_poll_interval() while talking to the device.
+		lock.unlock();
+		for (const auto &config_key : due_keys)
+			refresh_config(config_key);
+		lock.lock();
+	}
+}
+
 void Configurable::feed_in_meta(shared_ptr<sigrok::Meta> sr_meta)
 {
 	for (const auto &entry : sr_meta->config()) {
 		devices::ConfigKey config_key =
 			devices::deviceutil::get_config_key(entry.first);
 
-		if (!properties_.count(config_key)) {
+		if (!config_keys_.count(config_key)) {
 			qWarning() << "Configurable::feed_in_meta(): Unknown config key " <<
 				QString::fromStdString(entry.first->name()) << " received";
 			return;
 		}
 
-		properties_[config_key]->on_value_changed(entry.second);
+		update_cached_config(config_key, entry.second);
+		auto property = existing_property(config_key);
+		if (property)
+			property->on_value_changed(entry.second);
 
 		// TODO: return QVariant from prop->on_value_changed(); and emit
 		//Q_EMIT config_changed(config_key, qvar);
@@ -20,14 +20,20 @@
 #ifndef DEVICES_CONFIGURABLE_HPP
 #define DEVICES_CONFIGURABLE_HPP
 
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
 #include <glib.h>
+#include <glibmm.h>
 
 #include <QObject>
 #include <QString>
@@ -39,6 +45,7 @@
 using std::forward;
 using std::make_shared;
 using std::map;
+using std::mutex;
 using std::pair;
 using std::set;
 using std::shared_ptr;
@@ -63,6 +70,9 @@ class BaseProperty;
 
 namespace devices {
 
+class CapabilityCache;
+class ConfigQueue;
+
 class Configurable :
 	public QObject,
 	public std::enable_shared_from_this<Configurable>
@@ -72,7 +82,9 @@ class Configurable :
 private:
 	Configurable(const shared_ptr<sigrok::Configurable> sr_configurable,
 		unsigned int configurable_index,
-		const string device_name, const DeviceType device_type);
+		const string device_name, const DeviceType device_type,
+		shared_ptr<ConfigQueue> config_queue,
+		shared_ptr<CapabilityCache> capability_cache);
 
 public:
 	template<typename ...Arg>
@@ -89,14 +101,20 @@ public:
 		return configurable;
 	}
 
+	~Configurable();
 
 	/**
-	 * Init the properties (config keys) and default lists.
+	 * Init the config keys and their capabilities. The properties are
+	 * created (and their lists are loaded) on first use.
 	 * Must be called after instantiation and not from the ctor.
 	 */
 	void init();
 
 	bool has_get_config(devices::ConfigKey config_key) const;
+	/**
+	 * Return the value of the config key. The value is read from the cache,
+	 * only when the key hasn't been read before, the device is queried.
+	 */
 	template<typename T> T get_config(devices::ConfigKey config_key) const;
 	/**
 	 * Special handling for Conatiner Variants (especially std::tuple).
@@ -106,13 +124,22 @@ public:
 	Glib::VariantContainerBase get_container_config(devices::ConfigKey config_key) const;
 
 	bool has_set_config(devices::ConfigKey config_key) const;
+	/**
+	 * Set the value of the config key and wait until the device has been set.
+	 */
 	template<typename T> void set_config(devices::ConfigKey config_key, const T value);
+	/**
+	 * Queue the value of the config key and return immediately. A value for
+	 * the same key, that is still waiting in the queue, is replaced.
+	 */
+	template<typename T> void queue_set_config(devices::ConfigKey config_key, const T value);
 	/**
 	 * Special handling for Conatiner Variants (especially std::tuple).
 	 * Tuple types are only supported with version >= 2.52 of glibmm, but we
 	 * need to use version 2.42, because of mxe.
 	 */
 	void set_container_config(devices::ConfigKey config_key, vector<Glib::VariantBase> childs);
+	void queue_set_container_config(devices::ConfigKey config_key, vector<Glib::VariantBase> childs);
 
 	bool has_list_config(devices::ConfigKey config_key) const;
 	bool list_config(devices::ConfigKey config_key, Glib::VariantContainerBase &gvar);
@@ -141,23 +168,101 @@ public:
 	set<devices::ConfigKey> setable_configs() const;
 	set<devices::ConfigKey> listable_configs() const;
 
-	map<devices::ConfigKey, shared_ptr<data::properties::BaseProperty>> properties() const;
-	shared_ptr<data::properties::BaseProperty> get_property(devices::ConfigKey config_key) const;
+	bool has_property(devices::ConfigKey config_key) const;
+	/**
+	 * Return all config keys of the configurable, without creating the
+	 * properties.
+	 */
+	set<devices::ConfigKey> config_keys() const;
+	/**
+	 * Return the properties of all config keys. This creates all properties,
+	 * that haven't been used yet.
+	 */
+	map<devices::ConfigKey, shared_ptr<data::properties::BaseProperty>> properties();
+	/**
+	 * Return the property of the config key, the property is created on the
+	 * first call.
+	 */
+	shared_ptr<data::properties::BaseProperty> get_property(devices::ConfigKey config_key);
 
 	bool is_controllable() const;
 
+	/**
+	 * Read the value of the config key from the device and update the cache.
+	 * When the value has changed, the property is notified.
+	 */
+	bool refresh_config(devices::ConfigKey config_key);
+
+	/**
+	 * Set the interval in ms, in which the value of the config key is polled
+	 * from the device in the background. 0 disables polling for the key.
+	 */
+	void set_poll_interval(devices::ConfigKey config_key, int interval);
+	int poll_interval(devices::ConfigKey config_key) const;
+	/**
+	 * Stop the background polling, e.g. before the device is closed.
+	 */
+	void stop_polling();
+
 	void feed_in_meta(shared_ptr<sigrok::Meta> sr_meta);
 
 private:
+	typedef std::chrono::steady_clock::time_point poll_time_t;
+
+	shared_ptr<data::properties::BaseProperty> create_property(
+		devices::ConfigKey config_key);
+	/**
+	 * Return the property of the config key, if it has been created yet.
+	 */
+	shared_ptr<data::properties::BaseProperty> existing_property(
+		devices::ConfigKey config_key) const;
+	Glib::VariantBase get_cached_config(devices::ConfigKey config_key) const;
+	Glib::VariantBase read_config(devices::ConfigKey config_key) const;
+	/**
+	 * Store a value, that has been read from the device, in the cache. The
+	 * value is dropped, if a newer set than set_generation has been queued
+	 * in the meantime.
+	 *
+	 * @return true if the cached value has changed.
+	 */
+	bool update_cached_config(devices::ConfigKey config_key,
+		Glib::VariantBase gvar, uint64_t set_generation) const;
+	/**
+	 * Like refresh_config(), but the value is only used, if no newer set
+	 * than set_generation has been queued.
+	 */
+	bool refresh_config_at(devices::ConfigKey config_key,
+		uint64_t set_generation);
+	void set_variant_config(devices::ConfigKey config_key,
+		Glib::VariantBase gvar, bool wait);
+	void poll_thread_proc();
+
 	const shared_ptr<sigrok::Configurable> sr_configurable_;
 	unsigned int configurable_index_;
 	const string device_name_;
 	const DeviceType device_type_;
+	const shared_ptr<ConfigQueue> config_queue_;
+	const shared_ptr<CapabilityCache> capability_cache_;
 
+	set<devices::ConfigKey> config_keys_;
 	set<devices::ConfigKey> getable_configs_;
 	set<devices::ConfigKey> setable_configs_;
 	set<devices::ConfigKey> listable_configs_;
 	map<devices::ConfigKey, shared_ptr<data::properties::BaseProperty>> properties_;
+	mutable mutex properties_mutex_;
+
+	/** Serializes the config calls to the device (for list_config()). */
+	mutable mutex sr_mutex_;
+	/** Last known values of the config keys, read by the properties. */
+	mutable map<devices::ConfigKey, Glib::VariantBase> value_cache_;
+	mutable mutex cache_mutex_;
+
+	map<devices::ConfigKey, int> poll_intervals_;
+	map<devices::ConfigKey, poll_time_t> poll_next_;
+	std::thread poll_thread_;
+	bool poll_running_;
+	mutable mutex poll_mutex_;
+	std::condition_variable poll_cv_;
 
 Q_SIGNALS:
 	void config_changed(const devices::ConfigKey config_key, const QVariant qvar);
@@ -20,6 +20,8 @@
 
 #include <algorithm>
 #include <cassert>
+#include <memory>
+#include <set>
 #include <string>
 #include <thread>
 #include <utility>
@@ -27,7 +29,6 @@
 
 #include <glib.h>
 
-#include <QDateTime>
 #include <QDebug>
 #include <QString>
 
@@ -36,20 +37,25 @@
 #include "hardwaredevice.hpp"
 #include "src/devicemanager.hpp"
 #include "src/session.hpp"
+#include "src/sessionclock.hpp"
 #include "src/channels/basechannel.hpp"
 #include "src/channels/hardwarechannel.hpp"
+#include "src/data/datautil.hpp"
 #include "src/data/properties/uint64property.hpp"
 #include "src/devices/basedevice.hpp"
+#include "src/devices/capabilitycache.hpp"
+#include "src/devices/configqueue.hpp"
 #include "src/devices/configurable.hpp"
 #include "src/devices/deviceutil.hpp"
 
 using std::lock_guard;
 using std::make_pair;
+using std::make_shared;
 using std::map;
+using std::set;
 using std::shared_ptr;
 using std::static_pointer_cast;
 using std::string;
-using std::unique_ptr;
 using std::vector;
 
 namespace sv {
@@ -83,6 +89,13 @@ HardwareDevice::HardwareDevice(
 	}
 	if (device_type_ == DeviceType::Unknown)
 		assert("Unknown device");
+
+	// Serial and SCPI drivers may block in their receive callback, while
+	// waiting for the device. They get their own acquisition thread, so they
+	// can't stall the other devices on a shared acquisition worker.
+	if (sr_device->driver()->scan_options().count(
+			sigrok::ConfigKey::SERIALCOMM) > 0)
+		set_isolated_acquisition(true);
 }
 
 string HardwareDevice::id() const
@@ -173,6 +186,11 @@ shared_ptr<sigrok::HardwareDevice> HardwareDevice::sr_hardware_device() const
 
 void HardwareDevice::init_configurables()
 {
+	config_queue_ = make_shared<ConfigQueue>();
+	auto capability_cache = make_shared<CapabilityCache>(
+		sr_hardware_device()->driver()->name(), sr_device_->vendor(),
+		sr_device_->model(), sr_device_->version());
+
 	// Init Configurables from Channel Groups
 	for (const auto &sr_cg_pair : sr_device_->channel_groups()) {
 		auto sr_cg = sr_cg_pair.second;
@@ -181,7 +199,8 @@ void HardwareDevice::init_configurables()
 
 		auto cg_c = Configurable::create(
 			sr_cg, next_configurable_index_++,
-			short_name().toStdString(), device_type_);
+			short_name().toStdString(), device_type_, config_queue_,
+			capability_cache);
 		configurable_map_.insert(make_pair(sr_cg_pair.first, cg_c));
 	}
 
@@ -201,7 +220,8 @@ void HardwareDevice::init_configurables()
 	// Init Configurable from Device
 	auto d_c = Configurable::create(
 		sr_device_, next_configurable_index_++,
-		short_name().toStdString(), device_type_);
+		short_name().toStdString(), device_type_, config_queue_,
+		capability_cache);
 	configurable_map_.insert(make_pair("", d_c));
 
 	// Sample rate for interleaved samples
@@ -261,8 +281,7 @@ void HardwareDevice::feed_in_meta(shared_ptr<sigrok::Meta> sr_meta)
 
 void HardwareDevice::feed_in_frame_begin()
 {
-	// TODO: use std::chrono / std::time
-	frame_start_timestamp_ = QDateTime::currentMSecsSinceEpoch() / (double)1000;
+	frame_start_timestamp_ = SessionClock::now();
 	frame_began_ = true;
 }
 
@@ -278,47 +297,17 @@ void HardwareDevice::feed_in_logic(shared_ptr<sigrok::Logic> sr_logic)
 
 void HardwareDevice::feed_in_analog(shared_ptr<sigrok::Analog> sr_analog)
 {
-	size_t num_samples = sr_analog->num_samples();
-	if (num_samples == 0)
-		return;
-
-	lock_guard<recursive_mutex> lock(data_mutex_);
+	double timestamp;
+	if (frame_began_)
+		timestamp = frame_start_timestamp_;
+	else
+		timestamp = SessionClock::now();
 
 	uint64_t samplerate = 0;
 	if (samplerate_prop_ != nullptr)
 		samplerate = samplerate_prop_->uint64_value();
 
-	const vector<shared_ptr<sigrok::Channel>> sr_channels = sr_analog->channels();
-
-	unique_ptr<float[]> data(new float[num_samples * sr_channels.size()]);
-	sr_analog->get_data_as_float(data.get());
-	float *channel_data = data.get();
-
-	for (const auto &sr_channel : sr_channels) {
-		/*
-		qWarning() << "HardwareDevice::feed_in_analog(): HardwareDevice = " <<
-			QString::fromStdString(sr_device_->model()) <<
-			", Channel.Id = " <<
-			QString::fromStdString(sr_channel->name()) <<
-			" channel_data = " << *channel_data;
-		*/
-
-		if (!sr_channel_map_.count(sr_channel))
-			assert("Unknown channel");
-		auto channel = static_pointer_cast<channels::HardwareChannel>(
-			sr_channel_map_[sr_channel]);
-
-		// TODO: use std::chrono / std::time
-		double timestamp;
-		if (frame_began_)
-			timestamp = frame_start_timestamp_;
-		else
-			timestamp = QDateTime::currentMSecsSinceEpoch() / (double)1000;
-
-		//channel->push_sample_sr_analog(channel_data++, timestamp, sr_analog);
-		channel->push_interleaved_samples(channel_data++, num_samples,
-			sr_channels.size(), timestamp, samplerate, sr_analog);
-	}
+	push_analog_packet(sr_analog, timestamp, samplerate, sr_analog->digits());
 }
 
 } // namespace devices
@@ -0,0 +1,92 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2020 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+
+#include "ingestqueue.hpp"
+
+namespace sv {
+namespace devices {
+
+IngestQueue::IngestQueue(size_t capacity) :
+	head_(0),
+	tail_(0),
+	dropped_packets_(0),
+	dropped_samples_(0)
+{
+	assert(capacity > 0);
+
+	size_t size = 1;
+	while (size < capacity)
+		size <<= 1;
+	slots_.resize(size);
+	mask_ = size - 1;
+}
+
+analog_packet_t *IngestQueue::begin_push(size_t num_samples)
+{
+	const size_t head = head_.load(std::memory_order_relaxed);
+	const size_t tail = tail_.load(std::memory_order_acquire);
+	if (head - tail >= slots_.size()) {
+		++dropped_packets_;
+		dropped_samples_ += num_samples;
+		return nullptr;
+	}
+	return &slots_[head & mask_];
+}
+
+void IngestQueue::end_push()
+{
+	const size_t head = head_.load(std::memory_order_relaxed);
+	head_.store(head + 1, std::memory_order_release);
+}
+
+analog_packet_t *IngestQueue::front()
+{
+	const size_t tail = tail_.load(std::memory_order_relaxed);
+	const size_t head = head_.load(std::memory_order_acquire);
+	if (tail == head)
+		return nullptr;
+	return &slots_[tail & mask_];
+}
+
+void IngestQueue::pop()
+{
+	const size_t tail = tail_.load(std::memory_order_relaxed);
+	tail_.store(tail + 1, std::memory_order_release);
+}
+
+bool IngestQueue::empty() const
+{
+	return tail_.load(std::memory_order_acquire) ==
+		head_.load(std::memory_order_acquire);
+}
+
+size_t IngestQueue::size() const
+{
+	// Load the tail first, the head can only move ahead of it.
+	const size_t tail = tail_.load(std::memory_order_acquire);
+	const size_t head = head_.load(std::memory_order_acquire);
+	return head - tail;
+}
+
+} // namespace devices
+} // namespace sv
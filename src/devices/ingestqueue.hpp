@@ -0,0 +1,132 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2020 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef DEVICES_INGESTQUEUE_HPP
+#define DEVICES_INGESTQUEUE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+using std::atomic;
+using std::shared_ptr;
+using std::vector;
+
+namespace sigrok {
+class Channel;
+class Quantity;
+class QuantityFlag;
+class Unit;
+}
+
+namespace sv {
+namespace devices {
+
+/**
+ * Copy of the payload of a sigrok analog packet. The sigrok packet is only
+ * valid inside the datafeed callback, so everything needed to store the
+ * samples is copied.
+ */
+struct analog_packet_t
+{
+	/** Interleaved samples, num_samples per channel */
+	vector<float> data;
+	size_t num_samples;
+	vector<shared_ptr<sigrok::Channel>> sr_channels;
+	/** nullptr if the packet has no measured quantity */
+	const sigrok::Quantity *sr_quantity;
+	vector<const sigrok::QuantityFlag *> sr_quantity_flags;
+	const sigrok::Unit *sr_unit;
+	int digits;
+	unsigned int unit_size;
+	double timestamp;
+	uint64_t samplerate;
+	/** Individual timestamps of the samples, empty if the samples are
+	    spaced by the samplerate */
+	vector<double> timestamps;
+};
+
+/**
+ * Lock-free single producer / single consumer ring buffer for analog packets
+ * between the sigrok datafeed callback (producer) and the ingest thread of
+ * the device (consumer).
+ *
+ * The slots are allocated once and reused, so the sample buffers of the
+ * packets keep their capacity. The channel and quantity flag vectors are
+ * still allocated for every packet, because libsigrokcxx returns them as
+ * new vectors. When the ring is full, the packet is dropped and counted.
+ */
+class IngestQueue
+{
+
+public:
+	/**
+	 * @param capacity Number of packets, rounded up to a power of two.
+	 */
+	explicit IngestQueue(size_t capacity);
+
+	/**
+	 * Producer: Return the next free slot or nullptr if the ring is full. The
+	 * packet is counted as dropped in this case.
+	 *
+	 * @param num_samples Number of samples per channel, for the drop counter.
+	 */
+	analog_packet_t *begin_push(size_t num_samples);
+	/**
+	 * Producer: Publish the slot returned by begin_push().
+	 */
+	void end_push();
+
+	/**
+	 * Consumer: Return the oldest packet or nullptr if the ring is empty.
+	 */
+	analog_packet_t *front();
+	/**
+	 * Consumer: Release the packet returned by front().
+	 */
+	void pop();
+
+	size_t capacity() const { return slots_.size(); }
+	bool empty() const;
+	/**
+	 * Return the number of packets in the ring. Only a snapshot, when called
+	 * from a thread other than the producer or the consumer.
+	 */
+	size_t size() const;
+	uint64_t dropped_packets() const { return dropped_packets_; }
+	uint64_t dropped_samples() const { return dropped_samples_; }
+
+private:
+	vector<analog_packet_t> slots_;
+	size_t mask_;
+	/** Position of the next slot to write, only changed by the producer. */
+	atomic<size_t> head_;
+	/** Position of the next slot to read, only changed by the consumer. */
+	atomic<size_t> tail_;
+	atomic<uint64_t> dropped_packets_;
+	atomic<uint64_t> dropped_samples_;
+
+};
+
+} // namespace devices
+} // namespace sv
+
+#endif // DEVICES_INGESTQUEUE_HPP
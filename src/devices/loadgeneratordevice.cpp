@@ -0,0 +1,307 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2020 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <chrono>
+#include <cmath>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <libsigrokcxx/libsigrokcxx.hpp>
+
+#include <QDebug>
+
+#include "loadgeneratordevice.hpp"
+#include "config.h"
+#include "src/sessionclock.hpp"
+#include "src/channels/basechannel.hpp"
+#include "src/channels/hardwarechannel.hpp"
+#include "src/devices/basedevice.hpp"
+#include "src/devices/userdevice.hpp"
+
+/** Samples per period of the waveform */
+#define LOADGEN_PERIOD_SAMPLES 1000
+#define LOADGEN_DIGITS 3
+#define LOADGEN_NOISE_SEED 4711
+
+using std::lock_guard;
+using std::make_pair;
+using std::make_shared;
+using std::set;
+using std::shared_ptr;
+using std::static_pointer_cast;
+using std::string;
+using std::unique_lock;
+using std::vector;
+
+namespace sv {
+namespace devices {
+
+LoadGeneratorDevice::LoadGeneratorDevice(
+		const shared_ptr<sigrok::Context> &sr_context,
+		size_t channel_count, uint64_t samplerate, size_t packet_size,
+		LoadWaveform waveform) :
+	UserDevice(sr_context, "SmuView", "Load Generator", SV_VERSION_STRING),
+	channel_count_(channel_count > 0 ? channel_count : 1),
+	samplerate_(samplerate > 0 ? samplerate : 1),
+	packet_size_(packet_size > 0 ? packet_size : 1),
+	waveform_(waveform),
+	packet_timestamp_(0.),
+	generated_sample_count_(0),
+	ingested_sample_count_(0),
+	statistics_start_(0),
+	generator_running_(false)
+{
+	init_period();
+}
+
+LoadGeneratorDevice::~LoadGeneratorDevice()
+{
+	stop_generator();
+}
+
+string LoadGeneratorDevice::id() const
+{
+	return "loadgenerator:" + std::to_string(device_index_);
+}
+
+void LoadGeneratorDevice::close()
+{
+	// Stop sending packets before the ingest thread is stopped.
+	stop_generator();
+	UserDevice::close();
+}
+
+size_t LoadGeneratorDevice::channel_count() const
+{
+	return channel_count_;
+}
+
+uint64_t LoadGeneratorDevice::samplerate() const
+{
+	return samplerate_;
+}
+
+size_t LoadGeneratorDevice::packet_size() const
+{
+	return packet_size_;
+}
+
+LoadWaveform LoadGeneratorDevice::waveform() const
+{
+	return waveform_;
+}
+
+uint64_t LoadGeneratorDevice::generated_sample_count() const
+{
+	return generated_sample_count_;
+}
+
+uint64_t LoadGeneratorDevice::ingested_sample_count() const
+{
+	return ingested_sample_count_;
+}
+
+double LoadGeneratorDevice::generated_samplerate() const
+{
+	double elapsed = elapsed_statistics_time();
+	if (elapsed <= 0)
+		return 0;
+	return generated_sample_count_ / elapsed;
+}
+
+double LoadGeneratorDevice::ingested_samplerate() const
+{
+	double elapsed = elapsed_statistics_time();
+	if (elapsed <= 0)
+		return 0;
+	return ingested_sample_count_ / elapsed;
+}
+
+void LoadGeneratorDevice::reset_statistics()
+{
+	generated_sample_count_ = 0;
+	ingested_sample_count_ = 0;
+	statistics_start_ = std::chrono::duration_cast<std::chrono::nanoseconds>(
+		std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+double LoadGeneratorDevice::elapsed_statistics_time() const
+{
+	int64_t now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+		std::chrono::steady_clock::now().time_since_epoch()).count();
+	return (now - statistics_start_) / 1e9;
+}
+
+void LoadGeneratorDevice::init_period()
+{
+	period_.resize(LOADGEN_PERIOD_SAMPLES);
+
+	std::mt19937 generator(LOADGEN_NOISE_SEED);
+	std::uniform_real_distribution<float> distribution(-1, 1);
+
+	for (size_t i = 0; i < period_.size(); ++i) {
+		double x = i / (double)period_.size();
+		double value;
+		switch (waveform_) {
+		case LoadWaveform::Square:
+			value = x < 0.5 ? 1 : -1;
+			break;
+		case LoadWaveform::Triangle:
+			value = x < 0.5 ? 4 * x - 1 : 3 - 4 * x;
+			break;
+		case LoadWaveform::Sawtooth:
+			value = 2 * x - 1;
+			break;
+		case LoadWaveform::Noise:
+			value = distribution(generator);
+			break;
+		case LoadWaveform::Sine:
+		default:
+			value = sin(2 * M_PI * x);
+			break;
+		}
+		period_[i] = (float)value;
+	}
+}
+
+void LoadGeneratorDevice::init_channels()
+{
+	auto sr_user_device = static_pointer_cast<sigrok::UserDevice>(sr_device_);
+
+	for (size_t i = 0; i < channel_count_; ++i) {
+		string channel_name = "CH" + std::to_string(i + 1);
+		auto sr_channel = sr_user_device->add_channel(channel_index_++,
+			sigrok::ChannelType::ANALOG, channel_name);
+		sr_channels_.push_back(sr_channel);
+
+		/*
+		 * NOTE: The channels are hardware channels, so the samples are
+		 *       stored by BaseDevice::ingest_analog() like the samples
+		 *       of a real device.
+		 */
+		set<string> chg_names { "" };
+		auto channel = make_shared<channels::HardwareChannel>(sr_channel,
+			shared_from_this(), chg_names, aquisition_start_timestamp_);
+		sr_channel_map_.insert(make_pair(sr_channel, channel));
+		BaseDevice::add_channel(channel, "");
+	}
+}
+
+void LoadGeneratorDevice::init_acquisition()
+{
+	start_ingest();
+	aquisition_state_ = AquisitionState::Running;
+
+	generator_running_ = true;
+	generator_thread_ = std::thread(
+		&LoadGeneratorDevice::generator_thread_proc, this);
+}
+
+void LoadGeneratorDevice::stop_generator()
+{
+	{
+		lock_guard<mutex> lock(generator_mutex_);
+		generator_running_ = false;
+	}
+	generator_cv_.notify_all();
+
+	if (generator_thread_.joinable())
+		generator_thread_.join();
+}
+
+void LoadGeneratorDevice::feed_in_analog(shared_ptr<sigrok::Analog> sr_analog)
+{
+	push_analog_packet(sr_analog, packet_timestamp_, samplerate_,
+		LOADGEN_DIGITS);
+}
+
+void LoadGeneratorDevice::ingest_analog(const analog_packet_t &packet)
+{
+	BaseDevice::ingest_analog(packet);
+	ingested_sample_count_ += packet.num_samples;
+}
+
+void LoadGeneratorDevice::generator_thread_proc()
+{
+	using clock = std::chrono::steady_clock;
+
+	const size_t period_size = period_.size();
+	vector<size_t> phase_offsets;
+	for (size_t ch = 0; ch < channel_count_; ++ch)
+		phase_offsets.push_back(ch * period_size / channel_count_);
+
+	vector<float> data(packet_size_ * channel_count_);
+	vector<const sigrok::QuantityFlag *> sr_quantity_flags {
+		sigrok::QuantityFlag::DC };
+
+	double start_timestamp = SessionClock::now();
+	clock::time_point start = clock::now();
+	uint64_t sample_pos = 0;
+	reset_statistics();
+
+	while (generator_running_) {
+		size_t period_pos = sample_pos % period_size;
+		float *data_ptr = data.data();
+		for (size_t i = 0; i < packet_size_; ++i) {
+			for (size_t ch = 0; ch < channel_count_; ++ch) {
+				size_t pos = period_pos + phase_offsets[ch];
+				if (pos >= period_size)
+					pos -= period_size;
+				*data_ptr++ = period_[pos];
+			}
+			if (++period_pos == period_size)
+				period_pos = 0;
+		}
+
+		packet_timestamp_ = start_timestamp + sample_pos / (double)samplerate_;
+		auto sr_packet = sr_context_->create_analog_packet(sr_channels_,
+			data.data(), packet_size_, sigrok::Quantity::VOLTAGE,
+			sigrok::Unit::VOLT, sr_quantity_flags);
+		data_feed_in(sr_device_, sr_packet);
+
+		sample_pos += packet_size_;
+		generated_sample_count_ += packet_size_;
+
+		// The next packet is due, when its samples would have been measured.
+		// If the generator falls behind, it doesn't wait at all, so the
+		// achieved samplerate shows the limit of the data path.
+		clock::time_point due = start +
+			std::chrono::duration_cast<clock::duration>(
+				std::chrono::duration<double>(
+					sample_pos / (double)samplerate_));
+		if (clock::now() < due) {
+			unique_lock<mutex> lock(generator_mutex_);
+			generator_cv_.wait_until(lock, due,
+				[this]() { return !generator_running_; });
+		}
+	}
+
+	qDebug() << "LoadGeneratorDevice: Generated " <<
+		generated_sample_count_.load() << " samples/channel, " <<
+		ingested_sample_count_.load() << " ingested, " <<
+		dropped_sample_count() << " dropped";
+}
+
+} // namespace devices
+} // namespace sv
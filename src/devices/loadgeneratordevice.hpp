@@ -0,0 +1,176 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2020 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef DEVICES_LOADGENERATORDEVICE_HPP
+#define DEVICES_LOADGENERATORDEVICE_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <QObject>
+
+#include "src/devices/userdevice.hpp"
+
+using std::atomic;
+using std::mutex;
+using std::shared_ptr;
+using std::string;
+using std::vector;
+
+namespace sigrok {
+class Analog;
+class Channel;
+class Context;
+}
+
+namespace sv {
+namespace devices {
+
+enum class LoadWaveform
+{
+	Sine,
+	Square,
+	Triangle,
+	Sawtooth,
+	/** Uniformly distributed noise */
+	Noise
+};
+
+/**
+ * A virtual device, that generates analog samples at a high rate to stress
+ * test the data path (datafeed, ingest queue, signals, math channels, views).
+ *
+ * The samples of all channels are sent as interleaved sigrok analog packets
+ * through the same datafeed and ingest path as the samples of a hardware
+ * device. The generated samples, the samples stored in the signals and the
+ * samples dropped by the ingest queue are counted, so the achieved
+ * throughput of every stage can be compared with the requested samplerate.
+ */
+class LoadGeneratorDevice : public UserDevice
+{
+	Q_OBJECT
+
+public:
+	/**
+	 * @param channel_count Number of analog channels.
+	 * @param samplerate Samples per second and channel.
+	 * @param packet_size Samples per channel in one packet.
+	 * @param waveform The waveform of the generated samples.
+	 */
+	LoadGeneratorDevice(const shared_ptr<sigrok::Context> &sr_context,
+		size_t channel_count, uint64_t samplerate, size_t packet_size,
+		LoadWaveform waveform);
+	~LoadGeneratorDevice();
+
+	/**
+	 * Get the unique Id of the device
+	 */
+	string id() const override;
+
+	/**
+	 * Close the device and stop the generator.
+	 */
+	void close() override;
+
+	size_t channel_count() const;
+	uint64_t samplerate() const;
+	size_t packet_size() const;
+	LoadWaveform waveform() const;
+
+	/**
+	 * Return the number of generated samples per channel.
+	 */
+	uint64_t generated_sample_count() const;
+
+	/**
+	 * Return the number of samples per channel, that have been stored in the
+	 * signals by the ingest thread.
+	 */
+	uint64_t ingested_sample_count() const;
+
+	/**
+	 * Return the achieved generator samplerate per channel in Hz, since the
+	 * start or the last call of reset_statistics().
+	 */
+	double generated_samplerate() const;
+
+	/**
+	 * Return the achieved ingest samplerate per channel in Hz, since the
+	 * start or the last call of reset_statistics().
+	 */
+	double ingested_samplerate() const;
+
+	/**
+	 * Reset the sample counters and the time base of the samplerates.
+	 */
+	void reset_statistics();
+
+protected:
+	/**
+	 * Create the channels of the generator.
+	 */
+	void init_channels() override;
+	/**
+	 * Start the ingest thread and the generator thread.
+	 */
+	void init_acquisition() override;
+
+	void feed_in_analog(shared_ptr<sigrok::Analog> sr_analog) override;
+	void ingest_analog(const analog_packet_t &packet) override;
+
+private:
+	void init_period();
+	void stop_generator();
+	void generator_thread_proc();
+	double elapsed_statistics_time() const;
+
+	const size_t channel_count_;
+	const uint64_t samplerate_;
+	const size_t packet_size_;
+	const LoadWaveform waveform_;
+
+	/** One period of the waveform */
+	vector<float> period_;
+	vector<shared_ptr<sigrok::Channel>> sr_channels_;
+	/** Time stamp of the analog packet, that is sent through the datafeed */
+	double packet_timestamp_;
+
+	atomic<uint64_t> generated_sample_count_;
+	atomic<uint64_t> ingested_sample_count_;
+	/** Start of the statistics, steady clock in ns */
+	atomic<int64_t> statistics_start_;
+
+	std::thread generator_thread_;
+	atomic<bool> generator_running_;
+	mutex generator_mutex_;
+	std::condition_variable generator_cv_;
+
+};
+
+} // namespace devices
+} // namespace sv
+
+#endif // DEVICES_LOADGENERATORDEVICE_HPP
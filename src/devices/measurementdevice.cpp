@@ -48,12 +48,12 @@ void MeasurementDevice::init_configurables()
 		// Check if the device has the config key "Range". If so, each possible
 		// value of the config key "MeasuredQuantity" could have a different
 		// listing for "Range"!
-		if (configurable->properties().count(ConfigKey::Range) > 0 &&
-			configurable->properties().count(ConfigKey::MeasuredQuantity) > 0) {
+		if (configurable->has_property(ConfigKey::Range) &&
+			configurable->has_property(ConfigKey::MeasuredQuantity)) {
 
-			auto range_property = configurable->properties()[ConfigKey::Range];
+			auto range_property = configurable->get_property(ConfigKey::Range);
 			auto mq_property =
-				configurable->properties()[ConfigKey::MeasuredQuantity];
+				configurable->get_property(ConfigKey::MeasuredQuantity);
 			connect(
 				mq_property.get(), &data::properties::BaseProperty::value_changed,
 				range_property.get(), &data::properties::BaseProperty::list_config);
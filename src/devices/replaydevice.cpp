@@ -0,0 +1,506 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2020 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <libsigrokcxx/libsigrokcxx.hpp>
+
+#include <QDateTime>
+#include <QDebug>
+#include <QFile>
+#include <QFileInfo>
+#include <QStringList>
+#include <QTextStream>
+
+#include "replaydevice.hpp"
+#include "src/sessionclock.hpp"
+#include "src/channels/basechannel.hpp"
+#include "src/channels/hardwarechannel.hpp"
+#include "src/data/datautil.hpp"
+#include "src/devices/basedevice.hpp"
+#include "src/devices/deviceutil.hpp"
+#include "src/devices/userdevice.hpp"
+
+/** Recorded time in s, that is played back at once at maximum speed */
+#define REPLAY_MAX_SPEED_SLICE 0.1
+/** Max. number of samples of a track in one packet */
+#define REPLAY_PACKET_SIZE 1000
+/** Time in ms to wait for room in the ingest queue */
+#define REPLAY_QUEUE_WAIT 1
+#define REPLAY_MAX_DECIMAL_PLACES 12
+#define CSV_TIME_DATE_FORMAT "yyyy.MM.dd hh:mm:ss.zzz"
+
+using std::lock_guard;
+using std::make_pair;
+using std::make_shared;
+using std::map;
+using std::set;
+using std::shared_ptr;
+using std::static_pointer_cast;
+using std::string;
+using std::unique_lock;
+using std::vector;
+
+namespace sv {
+namespace devices {
+
+ReplayDevice::ReplayDevice(
+		const shared_ptr<sigrok::Context> &sr_context,
+		const string &file_name, double speed) :
+	UserDevice(sr_context, "SmuView", "Replay Device",
+		QFileInfo(QString::fromStdString(file_name)).fileName().toStdString()),
+	file_name_(file_name),
+	first_timestamp_(0.),
+	replay_start_timestamp_(0.),
+	packet_digits_(0),
+	speed_(speed),
+	loop_(false),
+	finished_(false),
+	replayed_sample_count_(0),
+	replay_duration_(0.),
+	replay_running_(false)
+{
+	load_file();
+}
+
+ReplayDevice::~ReplayDevice()
+{
+	stop_replay();
+}
+
+string ReplayDevice::id() const
+{
+	return "replaydevice:" + std::to_string(device_index_);
+}
+
+void ReplayDevice::close()
+{
+	// Stop sending packets before the ingest thread is stopped.
+	stop_replay();
+	UserDevice::close();
+}
+
+string ReplayDevice::file_name() const
+{
+	return file_name_;
+}
+
+void ReplayDevice::set_speed(double speed)
+{
+	speed_ = speed < 0 ? 0 : speed;
+	replay_cv_.notify_all();
+}
+
+double ReplayDevice::speed() const
+{
+	return speed_;
+}
+
+void ReplayDevice::set_loop(bool loop)
+{
+	loop_ = loop;
+}
+
+bool ReplayDevice::is_loop() const
+{
+	return loop_;
+}
+
+bool ReplayDevice::is_finished() const
+{
+	return finished_;
+}
+
+uint64_t ReplayDevice::replayed_sample_count() const
+{
+	return replayed_sample_count_;
+}
+
+double ReplayDevice::replay_duration() const
+{
+	return replay_duration_;
+}
+
+void ReplayDevice::load_file()
+{
+	QFile file(QString::fromStdString(file_name_));
+	if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+		throw std::runtime_error("Can't open file " + file_name_);
+
+	QTextStream in(&file);
+	in.setCodec("UTF-8");
+
+	// Header: Device names, channel group names, channel names, signal names
+	QStringList header_lines;
+	while (header_lines.size() < 4 && !in.atEnd())
+		header_lines << in.readLine();
+	if (header_lines.size() < 4)
+		throw std::runtime_error(file_name_ + " is not a SmuView CSV file");
+
+	// The separator can be set in the save dialog, so guess it from the
+	// signal names: Every signal has a time column and a value column.
+	QString sep;
+	QStringList signal_names;
+	for (const auto &candidate : { ",", ";", "\t", " " }) {
+		QStringList names = header_lines[3].split(candidate);
+		if (names.size() < 2 || names.size() % 2 != 0)
+			continue;
+		bool valid = true;
+		for (int i = 0; i < names.size(); i += 2)
+			valid = valid && names[i].startsWith("Time ");
+		if (valid) {
+			sep = candidate;
+			signal_names = names;
+			break;
+		}
+	}
+	if (sep.isEmpty())
+		throw std::runtime_error(file_name_ + " is not a SmuView CSV file");
+
+	QStringList device_names = header_lines[0].split(sep);
+	QStringList channel_names = header_lines[2].split(sep);
+	if (device_names.size() != signal_names.size() ||
+			channel_names.size() != signal_names.size()) {
+		throw std::runtime_error(
+			file_name_ + ": The header lines don't match");
+	}
+
+	// Channel names must be unique per device, so the device name is added
+	// for channels with the same name from different devices.
+	map<string, string> channel_device_map;
+	vector<track_t> tracks;
+	for (int i = 1; i < signal_names.size(); i += 2) {
+		track_t track;
+		string device_name = device_names[i].toStdString();
+		track.channel_name = channel_names[i].toStdString();
+		if (channel_device_map.count(track.channel_name) == 0)
+			channel_device_map[track.channel_name] = device_name;
+		else if (channel_device_map[track.channel_name] != device_name)
+			track.channel_name = device_name + " " + track.channel_name;
+		track.channel_group_name = device_name;
+		parse_signal_name(signal_names[i], track);
+		track.digits = 0;
+		track.pos = 0;
+		tracks.push_back(track);
+	}
+
+	// Data
+	while (!in.atEnd()) {
+		QStringList columns = in.readLine().split(sep);
+		for (size_t i = 0; i < tracks.size(); ++i) {
+			if ((int)(2*i + 1) >= columns.size())
+				break;
+			const QString &time_str = columns[2*i];
+			const QString &value_str = columns[2*i + 1];
+			if (time_str.isEmpty() || value_str.isEmpty())
+				continue;
+
+			bool ok;
+			double timestamp = time_str.toDouble(&ok);
+			if (!ok) {
+				QDateTime date_time =
+					QDateTime::fromString(time_str, CSV_TIME_DATE_FORMAT);
+				if (!date_time.isValid())
+					continue;
+				timestamp = date_time.toMSecsSinceEpoch() / (double)1000;
+			}
+			float value = value_str.toFloat(&ok);
+			if (!ok)
+				continue;
+
+			track_t &track = tracks[i];
+			track.timestamps.push_back(timestamp);
+			track.samples.push_back(value);
+			track.digits = std::max(track.digits, decimal_places(value_str));
+		}
+	}
+
+	bool has_samples = false;
+	for (auto &track : tracks) {
+		if (track.sr_quantity == nullptr || track.sr_unit == nullptr) {
+			qWarning() << "ReplayDevice::load_file(): Unknown quantity or " <<
+				"unit for channel " <<
+				QString::fromStdString(track.channel_name);
+			continue;
+		}
+		if (track.samples.empty())
+			continue;
+
+		if (!has_samples || track.timestamps[0] < first_timestamp_)
+			first_timestamp_ = track.timestamps[0];
+		has_samples = true;
+		tracks_.push_back(track);
+	}
+	if (!has_samples)
+		throw std::runtime_error(file_name_ + " doesn't contain any samples");
+}
+
+void ReplayDevice::parse_signal_name(const QString &signal_name,
+	track_t &track) const
+{
+	// The signal name is "<channel name> [<unit> <quantity flags>]"
+	QString mq_str;
+	int start = signal_name.lastIndexOf('[');
+	int end = signal_name.lastIndexOf(']');
+	if (start >= 0 && end > start)
+		mq_str = signal_name.mid(start + 1, end - start - 1);
+
+	// Use the longest matching unit name, e.g. "dBm" instead of "dB".
+	data::Unit unit = data::Unit::Unitless;
+	int unit_length = 0;
+	for (const auto &unit_pair : data::datautil::get_unit_name_map()) {
+		const QString &unit_name = unit_pair.second;
+		if (unit_name.isEmpty() || unit_name.length() <= unit_length)
+			continue;
+		if (mq_str == unit_name || mq_str.startsWith(unit_name + " ")) {
+			unit = unit_pair.first;
+			unit_length = unit_name.length();
+		}
+	}
+
+	set<data::QuantityFlag> quantity_flags;
+	QString flags_str = QString(" %1 ").arg(mq_str.mid(unit_length));
+	for (const auto &qf_pair : data::datautil::get_quantity_flag_name_map()) {
+		QString qf_name = QString(" %1 ").arg(qf_pair.second);
+		if (flags_str.contains(qf_name)) {
+			quantity_flags.insert(qf_pair.first);
+			flags_str.replace(qf_name, " ");
+		}
+	}
+
+	// The quantity is not exported, so derive it from the unit.
+	data::Quantity quantity = data::datautil::get_quantity_from_unit(unit);
+
+	track.sr_quantity = data::datautil::get_sr_quantity(quantity);
+	track.sr_quantity_flags =
+		data::datautil::get_sr_quantity_flags(quantity_flags);
+	track.sr_unit = data::datautil::get_sr_unit(unit);
+}
+
+int ReplayDevice::decimal_places(const QString &value_str)
+{
+	// The values are exported with QString::arg(double), e.g. "1.234" or
+	// "1.5e-06".
+	int exp_pos = value_str.indexOf('e', 0, Qt::CaseInsensitive);
+	QString mantissa = exp_pos < 0 ? value_str : value_str.left(exp_pos);
+	int exponent = exp_pos < 0 ? 0 : value_str.mid(exp_pos + 1).toInt();
+
+	int dot_pos = mantissa.indexOf('.');
+	int places = dot_pos < 0 ? 0 : mantissa.length() - dot_pos - 1;
+	places -= exponent;
+
+	if (places < 0)
+		return 0;
+	if (places > REPLAY_MAX_DECIMAL_PLACES)
+		return REPLAY_MAX_DECIMAL_PLACES;
+	return places;
+}
+
+void ReplayDevice::init_channels()
+{
+	auto sr_user_device = static_pointer_cast<sigrok::UserDevice>(sr_device_);
+
+	map<string, shared_ptr<sigrok::Channel>> sr_channels;
+	for (auto &track : tracks_) {
+		if (sr_channels.count(track.channel_name) == 0) {
+			auto sr_channel = sr_user_device->add_channel(channel_index_++,
+				sigrok::ChannelType::ANALOG, track.channel_name);
+			sr_channels[track.channel_name] = sr_channel;
+
+			/*
+			 * NOTE: The channels are hardware channels, so the samples are
+			 *       stored by BaseDevice::ingest_analog() like the samples
+			 *       of a real device. UserDevice::add_channel() would add a
+			 *       second sigrok channel.
+			 */
+			set<string> chg_names { track.channel_group_name };
+			auto channel = make_shared<channels::HardwareChannel>(sr_channel,
+				shared_from_this(), chg_names, aquisition_start_timestamp_);
+			sr_channel_map_.insert(make_pair(sr_channel, channel));
+			BaseDevice::add_channel(channel, track.channel_group_name);
+		}
+		track.sr_channel = sr_channels[track.channel_name];
+	}
+}
+
+void ReplayDevice::init_acquisition()
+{
+	start_ingest();
+	aquisition_state_ = AquisitionState::Running;
+
+	replay_running_ = true;
+	replay_thread_ = std::thread(&ReplayDevice::replay_thread_proc, this);
+}
+
+void ReplayDevice::stop_replay()
+{
+	{
+		lock_guard<mutex> lock(replay_mutex_);
+		replay_running_ = false;
+	}
+	replay_cv_.notify_all();
+
+	if (replay_thread_.joinable())
+		replay_thread_.join();
+}
+
+void ReplayDevice::feed_in_analog(shared_ptr<sigrok::Analog> sr_analog)
+{
+	push_analog_packet(sr_analog, packet_timestamps_.front(), 0,
+		packet_digits_, &packet_timestamps_);
+}
+
+bool ReplayDevice::wait_for_ingest_queue()
+{
+	unique_lock<mutex> lock(replay_mutex_);
+	while (replay_running_ &&
+			ingest_queue_.size() >= ingest_queue_.capacity()) {
+		replay_cv_.wait_for(lock,
+			std::chrono::milliseconds(REPLAY_QUEUE_WAIT));
+	}
+	return replay_running_;
+}
+
+bool ReplayDevice::replay_track(track_t &track, double replay_time)
+{
+	size_t sample_count = track.samples.size();
+	while (track.pos < sample_count &&
+			track.timestamps[track.pos] <= replay_time) {
+
+		size_t end = track.pos;
+		while (end < sample_count && end - track.pos < REPLAY_PACKET_SIZE &&
+				track.timestamps[end] <= replay_time)
+			++end;
+		size_t count = end - track.pos;
+
+		packet_timestamps_.resize(count);
+		for (size_t i = 0; i < count; ++i) {
+			packet_timestamps_[i] = replay_start_timestamp_ +
+				track.timestamps[track.pos + i] - first_timestamp_;
+		}
+		packet_digits_ = track.digits;
+
+		// Wait for the ingest thread instead of dropping the packet.
+		if (!wait_for_ingest_queue())
+			return false;
+
+		auto sr_packet = sr_context_->create_analog_packet(
+			vector<shared_ptr<sigrok::Channel>> { track.sr_channel },
+			&track.samples[track.pos], count, track.sr_quantity, track.sr_unit,
+			track.sr_quantity_flags);
+		data_feed_in(sr_device_, sr_packet);
+
+		track.pos = end;
+		replayed_sample_count_ += count;
+	}
+	return true;
+}
+
+void ReplayDevice::replay_thread_proc()
+{
+	using clock = std::chrono::steady_clock;
+
+	do {
+		for (auto &track : tracks_)
+			track.pos = 0;
+		finished_ = false;
+
+		replay_start_timestamp_ = SessionClock::now();
+		clock::time_point start = clock::now();
+
+		// The playback position is anchored to the wall clock and re-anchored
+		// when the speed changes.
+		double speed = speed_;
+		clock::time_point anchor = start;
+		double anchor_time = first_timestamp_;
+		double replay_time = first_timestamp_;
+
+		while (true) {
+			double next_time = 0;
+			bool has_next = false;
+			for (const auto &track : tracks_) {
+				if (track.pos >= track.samples.size())
+					continue;
+				if (!has_next || track.timestamps[track.pos] < next_time)
+					next_time = track.timestamps[track.pos];
+				has_next = true;
+			}
+			if (!has_next)
+				break;
+
+			if (speed_ != speed) {
+				speed = speed_;
+				anchor = clock::now();
+				anchor_time = replay_time;
+			}
+
+			if (speed > 0) {
+				clock::time_point due = anchor +
+					std::chrono::duration_cast<clock::duration>(
+						std::chrono::duration<double>(
+							(next_time - anchor_time) / speed));
+
+				unique_lock<mutex> lock(replay_mutex_);
+				if (replay_running_ && clock::now() < due)
+					replay_cv_.wait_until(lock, due);
+				if (!replay_running_)
+					return;
+				// Woken up early by a speed change or spuriously
+				if (clock::now() < due)
+					continue;
+				lock.unlock();
+
+				std::chrono::duration<double> elapsed = clock::now() - anchor;
+				replay_time = anchor_time + elapsed.count() * speed;
+			}
+			else {
+				{
+					lock_guard<mutex> lock(replay_mutex_);
+					if (!replay_running_)
+						return;
+				}
+				replay_time = next_time + REPLAY_MAX_SPEED_SLICE;
+			}
+
+			for (auto &track : tracks_) {
+				if (!replay_track(track, replay_time))
+					return;
+			}
+		}
+
+		std::chrono::duration<double> duration = clock::now() - start;
+		replay_duration_ = duration.count();
+		finished_ = true;
+		qWarning() << "ReplayDevice: Played back " <<
+			replayed_sample_count_.load() << " samples in " <<
+			replay_duration_.load() << " s";
+	} while (loop_ && replay_running_);
+}
+
+} // namespace devices
+} // namespace sv
@@ -0,0 +1,194 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2020 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef DEVICES_REPLAYDEVICE_HPP
+#define DEVICES_REPLAYDEVICE_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <QObject>
+#include <QString>
+
+#include "src/devices/userdevice.hpp"
+
+using std::atomic;
+using std::mutex;
+using std::shared_ptr;
+using std::string;
+using std::vector;
+
+namespace sigrok {
+class Analog;
+class Channel;
+class Context;
+class Quantity;
+class QuantityFlag;
+class Unit;
+}
+
+namespace sv {
+namespace devices {
+
+/**
+ * A virtual device, that plays back signals from a CSV file, that was
+ * exported by SmuView (relative or absolute time stamps, not combined).
+ *
+ * The samples are sent as sigrok analog packets through the same datafeed
+ * and ingest path as the samples of a hardware device. The time stamps of
+ * the played back samples keep the recorded spacing, starting at the time
+ * the playback was started, regardless of the playback speed.
+ */
+class ReplayDevice : public UserDevice
+{
+	Q_OBJECT
+
+public:
+	ReplayDevice(const shared_ptr<sigrok::Context> &sr_context,
+		const string &file_name, double speed);
+	~ReplayDevice();
+
+	/**
+	 * Get the unique Id of the device
+	 */
+	string id() const override;
+
+	/**
+	 * Close the device and stop the playback.
+	 */
+	void close() override;
+
+	/**
+	 * Return the name of the played back file.
+	 */
+	string file_name() const;
+
+	/**
+	 * Set the playback speed. 1.0 plays the samples back in real time,
+	 * 10.0 ten times as fast and 0 as fast as possible.
+	 */
+	void set_speed(double speed);
+	double speed() const;
+
+	/**
+	 * Restart the playback from the beginning, when the end of the file
+	 * is reached.
+	 */
+	void set_loop(bool loop);
+	bool is_loop() const;
+
+	/**
+	 * Return true, if all samples have been played back.
+	 */
+	bool is_finished() const;
+
+	/**
+	 * Return the number of samples (of all signals) played back so far.
+	 */
+	uint64_t replayed_sample_count() const;
+
+	/**
+	 * Return the time in seconds, the last complete playback of the file
+	 * took. Returns 0 if the playback hasn't finished yet.
+	 */
+	double replay_duration() const;
+
+protected:
+	/**
+	 * Create the channels for the signals in the file.
+	 */
+	void init_channels() override;
+	/**
+	 * Start the ingest thread and the replay thread.
+	 */
+	void init_acquisition() override;
+
+	void feed_in_analog(shared_ptr<sigrok::Analog> sr_analog) override;
+
+private:
+	/**
+	 * A signal from the file.
+	 */
+	struct track_t
+	{
+		string channel_name;
+		string channel_group_name;
+		/** nullptr if there is no matching sigrok quantity */
+		const sigrok::Quantity *sr_quantity;
+		vector<const sigrok::QuantityFlag *> sr_quantity_flags;
+		/** nullptr if there is no matching sigrok unit */
+		const sigrok::Unit *sr_unit;
+		/** Number of decimal places of the recorded values */
+		int digits;
+		vector<double> timestamps;
+		vector<float> samples;
+		shared_ptr<sigrok::Channel> sr_channel;
+		/** Position of the next sample to play back */
+		size_t pos;
+	};
+
+	void load_file();
+	void parse_signal_name(const QString &signal_name, track_t &track) const;
+	static int decimal_places(const QString &value_str);
+	void stop_replay();
+	void replay_thread_proc();
+	/**
+	 * Send all samples of the track up to replay_time through the
+	 * datafeed. Consecutive samples are sent in one packet. Returns false
+	 * if the replay has been stopped.
+	 */
+	bool replay_track(track_t &track, double replay_time);
+	/**
+	 * Wait until the ingest queue has room for a packet, so no samples are
+	 * dropped. Returns false if the replay has been stopped.
+	 */
+	bool wait_for_ingest_queue();
+
+	const string file_name_;
+	vector<track_t> tracks_;
+	/** The first recorded time stamp of the file */
+	double first_timestamp_;
+	/** The time stamp where the played back samples start */
+	double replay_start_timestamp_;
+	/** Time stamps of the analog packet, that is sent through the datafeed */
+	vector<double> packet_timestamps_;
+	int packet_digits_;
+
+	atomic<double> speed_;
+	atomic<bool> loop_;
+	atomic<bool> finished_;
+	atomic<uint64_t> replayed_sample_count_;
+	atomic<double> replay_duration_;
+
+	std::thread replay_thread_;
+	atomic<bool> replay_running_;
+	mutex replay_mutex_;
+	std::condition_variable replay_cv_;
+
+};
+
+} // namespace devices
+} // namespace sv
+
+#endif // DEVICES_REPLAYDEVICE_HPP
@@ -98,12 +98,15 @@ protected:
 	void feed_in_logic(shared_ptr<sigrok::Logic> sr_logic) override;
 	void feed_in_analog(shared_ptr<sigrok::Analog> sr_analog) override;
 
+protected:
+	/** Index of the next sigrok channel of the user device */
+	unsigned int channel_index_;
+
 private:
 	double frame_start_timestamp_;
 	string vendor_;
 	string model_;
 	string version_;
-	unsigned int channel_index_;
 
 };
 
@@ -20,6 +20,7 @@
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include <QApplication>
 #include <QDebug>
@@ -54,12 +55,14 @@
 #include "src/ui/tabs/tabhelper.hpp"
 #include "src/ui/tabs/welcometab.hpp"
 #include "src/ui/views/devicesview.hpp"
+#include "src/ui/views/diagnosticsview.hpp"
 #include "src/ui/views/smuscripttreeview.hpp"
 
 using std::make_pair;
 using std::make_shared;
 using std::shared_ptr;
 using std::string;
+using std::vector;
 
 Q_DECLARE_SMART_POINTER_METATYPE(std::shared_ptr)
 Q_DECLARE_METATYPE(std::shared_ptr<sv::devices::BaseDevice>)
@@ -71,7 +74,8 @@ namespace sv
 
 MainWindow::MainWindow(DeviceManager &device_manager, QWidget *parent) :
 	QMainWindow(parent),
-	device_manager_(device_manager)
+	device_manager_(device_manager),
+	is_default_session_(false)
 {
 	qRegisterMetaType<util::Timestamp>("util::Timestamp");
 	qRegisterMetaType<uint64_t>("uint64_t");
@@ -102,20 +106,25 @@ void MainWindow::init_session()
 	session_ = make_shared<Session>(device_manager_, this);
 }
 
+shared_ptr<Session> MainWindow::session() const
+{
+	return session_;
+}
+
 void MainWindow::init_default_session()
 {
-	if (device_manager_.user_spec_devices().empty()) {
+	is_default_session_ = true;
+
+	// The devices found so far, the others are added when the device
+	// manager finds them.
+	for (const auto &device : device_manager_.user_spec_devices())
+		on_user_spec_device_found(device);
+
+	if (device_manager_.user_spec_devices().empty() &&
+			!device_manager_.is_user_spec_scanning()) {
 		// Display the WelcomeTab if no DeviceTabs will be opened, because
 		// without a tab in the QTabWidget the main window looks so empty...
 		add_welcome_tab();
-		return;
-	}
-
-	for (const auto &device : device_manager_.user_spec_devices()) {
-		// NOTE: add_device() must be called, before the device tab
-		//       tries to access the device (device is not opend yet).
-		session_->add_device(device);
-		add_device_tab(device);
 	}
 }
 
@@ -149,6 +158,11 @@ void MainWindow::restore_session()
 
 void MainWindow::run_smu_script(string script_file)
 {
+	if (device_manager_.is_user_spec_scanning()) {
+		pending_script_file_ = script_file;
+		return;
+	}
+
 	add_smuscript_tab(script_file);
 	session_->smu_script_runner()->run(script_file);
 }
@@ -282,6 +296,18 @@ void MainWindow::setup_ui()
 	script_dock->setWidget(smu_script_tree_view_);
 	this->tabifyDockWidget(dev_dock, script_dock);
 
+	// Diagnostics Dock
+	diagnostics_view_ = new ui::views::DiagnosticsView(*session_);
+
+	QDockWidget* diagnostics_dock =
+		new QDockWidget(diagnostics_view_->title());
+	diagnostics_dock->setAllowedAreas(Qt::AllDockWidgetAreas);
+	diagnostics_dock->setContextMenuPolicy(Qt::PreventContextMenu);
+	diagnostics_dock->setFeatures(QDockWidget::DockWidgetMovable |
+		QDockWidget::DockWidgetFloatable);
+	diagnostics_dock->setWidget(diagnostics_view_);
+	this->tabifyDockWidget(script_dock, diagnostics_dock);
+
 	// Select device tree dock tab
 	dev_dock->show();
 	dev_dock->raise();
@@ -292,6 +318,43 @@ void MainWindow::connect_signals()
 	// Connect error handlers
 	connect(session_->smu_script_runner().get(), &python::SmuScriptRunner::script_error,
 		this, &MainWindow::error_handler);
+
+	// Devices from the background scan
+	connect(&device_manager_, &DeviceManager::user_spec_device_found,
+		this, &MainWindow::on_user_spec_device_found);
+	connect(&device_manager_, &DeviceManager::user_spec_scan_finished,
+		this, &MainWindow::on_user_spec_scan_finished);
+	connect(&device_manager_, &DeviceManager::scan_finished,
+		this, &MainWindow::on_scan_finished);
+}
+
+void MainWindow::on_user_spec_device_found(
+	shared_ptr<sv::devices::HardwareDevice> device)
+{
+	if (!is_default_session_)
+		return;
+
+	// NOTE: add_device() must be called, before the device tab
+	//       tries to access the device (device is not opend yet).
+	session_->add_device(device);
+	add_device_tab(device);
+}
+
+void MainWindow::on_user_spec_scan_finished()
+{
+	if (pending_script_file_.empty())
+		return;
+
+	string script_file = pending_script_file_;
+	pending_script_file_.clear();
+	run_smu_script(script_file);
+}
+
+void MainWindow::on_scan_finished()
+{
+	// No user specified device has been found.
+	if (is_default_session_ && tab_widget_->count() == 0)
+		add_welcome_tab();
 }
 
 void MainWindow::error_handler(
@@ -46,6 +46,7 @@ class BaseTab;
 }
 namespace views {
 class DevicesView;
+class DiagnosticsView;
 class SmuScriptTreeView;
 }
 }
@@ -61,12 +62,17 @@ public:
 	~MainWindow();
 
 	void init_session();
+	shared_ptr<Session> session() const;
 	void init_default_session();
 	void init_session_with_file(string open_file_name, string open_file_format);
 	void save_session();
 	void restore_session();
 
 	// TODO: Move to Session, when Session init is in main.cpp
+	/**
+	 * Run the SmuScript. While the user specified devices are still scanned,
+	 * the script is started after the scan, so it can use the devices.
+	 */
 	void run_smu_script(string script_file);
 
 	void add_smuscript_tab(string file_name);
@@ -84,9 +90,14 @@ private:
 
 	DeviceManager &device_manager_;
 	shared_ptr<Session> session_;
+	/** Open the user specified devices, as soon as they are found. */
+	bool is_default_session_;
+	/** SmuScript, that waits for the user specified devices. */
+	string pending_script_file_;
 
 	QWidget *central_widget_;
 	ui::views::DevicesView *devices_view_;
+	ui::views::DiagnosticsView *diagnostics_view_;
 	ui::views::SmuScriptTreeView *smu_script_tree_view_;
 	QTabWidget *tab_widget_;
 	/** tab_window_map_ is used to get the index of the tab in the QTabWidget */
@@ -95,6 +106,10 @@ private:
 private Q_SLOTS:
 	void error_handler(const std::string &sender, const std::string &msg);
 	void on_tab_close_requested(int tab_index);
+	void on_user_spec_device_found(
+		shared_ptr<sv::devices::HardwareDevice> device);
+	void on_user_spec_scan_finished();
+	void on_scan_finished();
 
 public Q_SLOTS:
 	void add_device_tab(shared_ptr<sv::devices::BaseDevice> device);
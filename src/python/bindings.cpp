@@ -27,7 +27,9 @@
 #include "config.h"
 #include "src/session.hpp"
 #include "src/channels/basechannel.hpp"
+#include "src/channels/eventdetectorchannel.hpp"
 #include "src/channels/hardwarechannel.hpp"
+#include "src/channels/mathchannel.hpp"
 #include "src/channels/userchannel.hpp"
 #include "src/data/analogbasesignal.hpp"
 #include "src/data/analogsamplesignal.hpp"
@@ -38,6 +40,8 @@
 #include "src/devices/configurable.hpp"
 #include "src/devices/deviceutil.hpp"
 #include "src/devices/hardwaredevice.hpp"
+#include "src/devices/loadgeneratordevice.hpp"
+#include "src/devices/replaydevice.hpp"
 #include "src/devices/userdevice.hpp"
 #include "src/python/pystreambuf.hpp"
 #include "src/python/uiproxy.hpp"
@@ -127,6 +131,38 @@ void init_Session(py::module &m)
 		"-------\n"
 		"UserDevice\n"
 		"    The created user device object.");
+	py_session.def("add_replay_device", &sv::Session::add_replay_device,
+		py::arg("file_name"), py::arg("speed") = 1.0,
+		"Create a new replay device, that plays back the signals from a CSV file exported by SmuView.\n\n"
+		"Parameters\n"
+		"----------\n"
+		"file_name : str\n"
+		"    The CSV file with the recorded signals.\n"
+		"speed : float\n"
+		"    The playback speed. 1.0 is real time, 0 is as fast as possible.\n\n"
+		"Returns\n"
+		"-------\n"
+		"ReplayDevice\n"
+		"    The created replay device object.");
+	py_session.def("add_load_generator_device", &sv::Session::add_load_generator_device,
+		py::arg("channel_count") = 1, py::arg("samplerate") = 1000,
+		py::arg("packet_size") = 100,
+		py::arg("waveform") = sv::devices::LoadWaveform::Sine,
+		"Create a new load generator device, that generates samples at a high rate for stress testing.\n\n"
+		"Parameters\n"
+		"----------\n"
+		"channel_count : int\n"
+		"    The number of analog channels.\n"
+		"samplerate : int\n"
+		"    The samplerate per channel in Hz.\n"
+		"packet_size : int\n"
+		"    The number of samples per channel in one packet.\n"
+		"waveform : LoadWaveform\n"
+		"    The waveform of the generated samples.\n\n"
+		"Returns\n"
+		"-------\n"
+		"LoadGeneratorDevice\n"
+		"    The created load generator device object.");
 }
 
 void init_Device(py::module &m)
@@ -170,12 +206,166 @@ void init_Device(py::module &m)
 		"-------\n"
 		"UserChannel\n"
 		"    The new user channel object.");
+	py_base_device.def("acquisition_statistics", &sv::devices::BaseDevice::acquisition_statistics,
+		"Return the acquisition statistics of the device. The rates are updated once per second.\n\n"
+		"Returns\n"
+		"-------\n"
+		"AcquisitionStatistics\n"
+		"    The acquisition statistics.");
+	py_base_device.def("acquisition_health", &sv::devices::BaseDevice::acquisition_health,
+		"Return the acquisition health of the device, derived from the acquisition statistics.\n\n"
+		"Returns\n"
+		"-------\n"
+		"AcquisitionHealth\n"
+		"    The acquisition health.");
+	py_base_device.def("set_isolated_acquisition", &sv::devices::BaseDevice::set_isolated_acquisition,
+		py::arg("isolated"),
+		"Run the acquisition of the device in its own thread instead of a shared acquisition worker "
+		"(see the `-w` command line option). Takes effect, when the device is opened the next time. "
+		"Devices with serial or SCPI drivers are isolated by default.\n\n"
+		"Parameters\n"
+		"----------\n"
+		"isolated : bool\n"
+		"    `True` to use an own acquisition thread.");
+	py_base_device.def("is_isolated_acquisition", &sv::devices::BaseDevice::is_isolated_acquisition,
+		"Return if the acquisition of the device runs in its own thread.\n\n"
+		"Returns\n"
+		"-------\n"
+		"bool\n"
+		"    `True` if the device uses an own acquisition thread.");
+	py_base_device.def("set_latency_offset", &sv::devices::BaseDevice::set_latency_offset,
+		py::arg("latency_offset"),
+		"Set the latency offset of the device. The offset is subtracted from the timestamps of all "
+		"received samples, to align the signals of devices with a different measurement delay.\n\n"
+		"Parameters\n"
+		"----------\n"
+		"latency_offset : float\n"
+		"    The latency offset in seconds.");
+	py_base_device.def("latency_offset", &sv::devices::BaseDevice::latency_offset,
+		"Return the latency offset of the device.\n\n"
+		"Returns\n"
+		"-------\n"
+		"float\n"
+		"    The latency offset in seconds.");
+
+	py::class_<sv::devices::acquisition_statistics_t> py_acquisition_statistics(m, "AcquisitionStatistics");
+	py_acquisition_statistics.doc() = "The acquisition statistics of a device.";
+	py_acquisition_statistics.def_readonly("packet_count", &sv::devices::acquisition_statistics_t::packet_count,
+		"Number of received packets.");
+	py_acquisition_statistics.def_readonly("sample_count", &sv::devices::acquisition_statistics_t::sample_count,
+		"Number of received samples per channel.");
+	py_acquisition_statistics.def_readonly("packet_rate", &sv::devices::acquisition_statistics_t::packet_rate,
+		"Received packets per second.");
+	py_acquisition_statistics.def_readonly("sample_rate", &sv::devices::acquisition_statistics_t::sample_rate,
+		"Received samples per second and channel.");
+	py_acquisition_statistics.def_readonly("feed_in_time_avg", &sv::devices::acquisition_statistics_t::feed_in_time_avg,
+		"Average time in µs to hand a packet over to the ingest queue.");
+	py_acquisition_statistics.def_readonly("feed_in_time_max", &sv::devices::acquisition_statistics_t::feed_in_time_max,
+		"Max. time in µs to hand a packet over to the ingest queue.");
+	py_acquisition_statistics.def_readonly("ingest_time_avg", &sv::devices::acquisition_statistics_t::ingest_time_avg,
+		"Average time in µs to store a packet in the signals.");
+	py_acquisition_statistics.def_readonly("ingest_time_max", &sv::devices::acquisition_statistics_t::ingest_time_max,
+		"Max. time in µs to store a packet in the signals.");
+	py_acquisition_statistics.def_readonly("queue_depth", &sv::devices::acquisition_statistics_t::queue_depth,
+		"Number of packets waiting in the ingest queue.");
+	py_acquisition_statistics.def_readonly("queue_capacity", &sv::devices::acquisition_statistics_t::queue_capacity,
+		"Capacity of the ingest queue in packets.");
+	py_acquisition_statistics.def_readonly("dropped_packet_count", &sv::devices::acquisition_statistics_t::dropped_packet_count,
+		"Number of dropped packets.");
+	py_acquisition_statistics.def_readonly("dropped_sample_count", &sv::devices::acquisition_statistics_t::dropped_sample_count,
+		"Number of dropped samples per channel.");
+	py_acquisition_statistics.def_readonly("dropped_sample_rate", &sv::devices::acquisition_statistics_t::dropped_sample_rate,
+		"Dropped samples per second and channel.");
+	py_acquisition_statistics.def_readonly("time_since_last_packet", &sv::devices::acquisition_statistics_t::time_since_last_packet,
+		"Time in s since the last packet, -1 if no packet has been received.");
+	py_acquisition_statistics.def_readonly("config_latency_last", &sv::devices::acquisition_statistics_t::config_latency_last,
+		"Latency in ms of the last config set, -1 if no config has been set.");
+	py_acquisition_statistics.def_readonly("config_latency_max", &sv::devices::acquisition_statistics_t::config_latency_max,
+		"Max. latency in ms of all config sets, -1 if no config has been set.");
+	py_acquisition_statistics.def_readonly("config_queue_depth", &sv::devices::acquisition_statistics_t::config_queue_depth,
+		"Number of config commands waiting to be executed.");
 
 	py::class_<sv::devices::HardwareDevice, std::shared_ptr<sv::devices::HardwareDevice>> py_hardware_device(m, "HardwareDevice", py_base_device);
 	py_hardware_device.doc() = "An actual hardware device.";
 
 	py::class_<sv::devices::UserDevice, std::shared_ptr<sv::devices::UserDevice>> py_user_device(m, "UserDevice", py_base_device);
 	py_user_device.doc() = "An user generated (virtual) device for storing custom data and showing a custom tab.";
+
+	py::class_<sv::devices::ReplayDevice, std::shared_ptr<sv::devices::ReplayDevice>> py_replay_device(m, "ReplayDevice", py_user_device);
+	py_replay_device.doc() = "A virtual device, that plays back recorded signals through the same data path as a hardware device.";
+	py_replay_device.def("set_speed", &sv::devices::ReplayDevice::set_speed,
+		py::arg("speed"),
+		"Set the playback speed.\n\n"
+		"Parameters\n"
+		"----------\n"
+		"speed : float\n"
+		"    1.0 is real time, 10.0 is ten times as fast and 0 is as fast as possible.");
+	py_replay_device.def("speed", &sv::devices::ReplayDevice::speed,
+		"Return the playback speed.\n\n"
+		"Returns\n"
+		"-------\n"
+		"float\n"
+		"    The playback speed.");
+	py_replay_device.def("set_loop", &sv::devices::ReplayDevice::set_loop,
+		py::arg("loop"),
+		"Restart the playback when the end of the file is reached.\n\n"
+		"Parameters\n"
+		"----------\n"
+		"loop : bool\n"
+		"    `True` to play back the file in a loop.");
+	py_replay_device.def("is_finished", &sv::devices::ReplayDevice::is_finished,
+		"Return whether all samples have been played back.\n\n"
+		"Returns\n"
+		"-------\n"
+		"bool\n"
+		"    `True` if the playback has finished.");
+	py_replay_device.def("replayed_sample_count", &sv::devices::ReplayDevice::replayed_sample_count,
+		"Return the number of samples played back so far.\n\n"
+		"Returns\n"
+		"-------\n"
+		"int\n"
+		"    The number of samples of all signals.");
+	py_replay_device.def("replay_duration", &sv::devices::ReplayDevice::replay_duration,
+		"Return the time the last complete playback took.\n\n"
+		"Returns\n"
+		"-------\n"
+		"float\n"
+		"    The duration in seconds, 0 if the playback hasn't finished yet.");
+
+	py::class_<sv::devices::LoadGeneratorDevice, std::shared_ptr<sv::devices::LoadGeneratorDevice>> py_load_generator_device(m, "LoadGeneratorDevice", py_user_device);
+	py_load_generator_device.doc() = "A virtual device, that generates samples at a high rate through the same data path as a hardware device.";
+	py_load_generator_device.def("generated_sample_count", &sv::devices::LoadGeneratorDevice::generated_sample_count,
+		"Return the number of generated samples per channel.\n\n"
+		"Returns\n"
+		"-------\n"
+		"int\n"
+		"    The number of generated samples.");
+	py_load_generator_device.def("ingested_sample_count", &sv::devices::LoadGeneratorDevice::ingested_sample_count,
+		"Return the number of samples per channel, that have been stored in the signals.\n\n"
+		"Returns\n"
+		"-------\n"
+		"int\n"
+		"    The number of stored samples.");
+	py_load_generator_device.def("dropped_sample_count", &sv::devices::LoadGeneratorDevice::dropped_sample_count,
+		"Return the number of samples per channel, that have been dropped because the ingest queue was full.\n\n"
+		"Returns\n"
+		"-------\n"
+		"int\n"
+		"    The number of dropped samples.");
+	py_load_generator_device.def("generated_samplerate", &sv::devices::LoadGeneratorDevice::generated_samplerate,
+		"Return the achieved samplerate of the generator.\n\n"
+		"Returns\n"
+		"-------\n"
+		"float\n"
+		"    The samplerate per channel in Hz since the start or the last `reset_statistics()`.");
+	py_load_generator_device.def("ingested_samplerate", &sv::devices::LoadGeneratorDevice::ingested_samplerate,
+		"Return the achieved samplerate of storing the samples in the signals.\n\n"
+		"Returns\n"
+		"-------\n"
+		"float\n"
+		"    The samplerate per channel in Hz since the start or the last `reset_statistics()`.");
+	py_load_generator_device.def("reset_statistics", &sv::devices::LoadGeneratorDevice::reset_statistics,
+		"Reset the sample counters and the time base of the samplerates.");
 }
 
 void init_Channel(py::module &m)
@@ -245,6 +435,72 @@ void init_Channel(py::module &m)
 		"    The total number of digits.\n"
 		"decimal_places : int\n"
 		"    The number of decimal places.");
+
+	py::class_<sv::channels::MathChannel, std::shared_ptr<sv::channels::MathChannel>> py_math_channel(m, "MathChannel", py_base_channel);
+	py_math_channel.doc() = "A channel that calculates its samples from other signals.";
+
+	py::class_<sv::channels::EventDetectorChannel, std::shared_ptr<sv::channels::EventDetectorChannel>> py_event_detector_channel(m, "EventDetectorChannel", py_math_channel);
+	py_event_detector_channel.doc() = "A math channel that detects the crossings of a signal through a threshold level.";
+	py_event_detector_channel.def("event_count", &sv::channels::EventDetectorChannel::event_count,
+		"Return the number of detected events.\n\n"
+		"Returns\n"
+		"-------\n"
+		"int\n"
+		"    The number of events.");
+	py_event_detector_channel.def("get_event", &sv::channels::EventDetectorChannel::get_event,
+		py::arg("pos"), py::arg("relative_time"),
+		"Return the event at the given position.\n\n"
+		"Parameters\n"
+		"----------\n"
+		"pos : int\n"
+		"    The position of the event.\n"
+		"relative_time : bool\n"
+		"    When `True`, the returned timestamp is relative to the start timestamp of the signal.\n\n"
+		"Returns\n"
+		"-------\n"
+		"Tuple[float, bool]\n"
+		"    The timestamp of the event and `True` for a rising edge.");
+	py_event_detector_channel.def("next_event", &sv::channels::EventDetectorChannel::next_event,
+		py::arg("timestamp"), py::arg("relative_time"),
+		"Return the position of the first event after the given timestamp.\n\n"
+		"Parameters\n"
+		"----------\n"
+		"timestamp : float\n"
+		"    The timestamp to search from.\n"
+		"relative_time : bool\n"
+		"    When `True`, the timestamp is relative to the start timestamp of the signal.\n\n"
+		"Returns\n"
+		"-------\n"
+		"int\n"
+		"    The position of the event or -1 if there is no event.");
+	py_event_detector_channel.def("previous_event", &sv::channels::EventDetectorChannel::previous_event,
+		py::arg("timestamp"), py::arg("relative_time"),
+		"Return the position of the last event before the given timestamp.\n\n"
+		"Parameters\n"
+		"----------\n"
+		"timestamp : float\n"
+		"    The timestamp to search from.\n"
+		"relative_time : bool\n"
+		"    When `True`, the timestamp is relative to the start timestamp of the signal.\n\n"
+		"Returns\n"
+		"-------\n"
+		"int\n"
+		"    The position of the event or -1 if there is no event.");
+	py_event_detector_channel.def("events_between", &sv::channels::EventDetectorChannel::events_between,
+		py::arg("start_timestamp"), py::arg("end_timestamp"), py::arg("relative_time"),
+		"Return the timestamps of all events in the given time range.\n\n"
+		"Parameters\n"
+		"----------\n"
+		"start_timestamp : float\n"
+		"    The start of the time range.\n"
+		"end_timestamp : float\n"
+		"    The end of the time range.\n"
+		"relative_time : bool\n"
+		"    When `True`, the timestamps are relative to the start timestamp of the signal.\n\n"
+		"Returns\n"
+		"-------\n"
+		"List[float]\n"
+		"    The timestamps of the events.");
 }
 
 void init_Signal(py::module &m)
@@ -458,6 +714,29 @@ void init_Configurable(py::module &m)
 		"-------\n"
 		"str\n"
 		"    The string value of the config key.");
+	py_configurable.def("refresh_config", &sv::devices::Configurable::refresh_config,
+		py::arg("config_key"),
+		"Read the value of the given config key from the device. `get_config()` "
+		"returns the cached value of the config key, which is updated by "
+		"`set_config()`, by the device and by the background polling.\n\n"
+		"Parameters\n"
+		"----------\n"
+		"config_key : ConfigKey\n"
+		"    The `ConfigKey` to read.\n\n"
+		"Returns\n"
+		"-------\n"
+		"bool\n"
+		"    True when the value could be read from the device.");
+	py_configurable.def("set_poll_interval", &sv::devices::Configurable::set_poll_interval,
+		py::arg("config_key"), py::arg("interval"),
+		"Set the interval, in which the value of the given config key is polled "
+		"from the device in the background.\n\n"
+		"Parameters\n"
+		"----------\n"
+		"config_key : ConfigKey\n"
+		"    The `ConfigKey` to poll.\n"
+		"interval : int\n"
+		"    The poll interval in ms. 0 disables polling.");
 }
 
 void init_UI(py::module &m)
@@ -507,6 +786,21 @@ void init_UI(py::module &m)
 		"-------\n"
 		"str\n"
 		"    The id of the new view.");
+	py_ui_helper.def("add_histogram_view", &sv::python::UiProxy::ui_add_histogram_view,
+		py::arg("device_id"), py::arg("area"), py::arg("signal"),
+		"Add a histogram view for a signal to the given tab.\n\n"
+		"Parameters\n"
+		"----------\n"
+		"device_id : str\n"
+		"    The id (device id) of the tab.\n"
+		"area : DockArea\n"
+		"    Where to put the new view.\n"
+		"signal : AnalogTimeSignal\n"
+		"    The signal object.\n\n"
+		"Returns\n"
+		"-------\n"
+		"str\n"
+		"    The id of the new view.");
 	py_ui_helper.def("add_plot_view",
 		(std::string (sv::python::UiProxy::*) (std::string, Qt::DockWidgetArea, shared_ptr<sv::channels::BaseChannel>))
 			&sv::python::UiProxy::ui_add_plot_view,
@@ -860,6 +1154,28 @@ void init_Enums(py::module &m)
 	py_config_key.value("Unknown", sv::devices::ConfigKey::Unknown,
 		"Unknown config key.");
 
+	py::enum_<sv::devices::AcquisitionHealth> py_acquisition_health(m, "AcquisitionHealth",
+		"Enum of the acquisition health states of a device.");
+	py_acquisition_health.value("Idle", sv::devices::AcquisitionHealth::Idle,
+		"No samples have been received yet.");
+	py_acquisition_health.value("Ok", sv::devices::AcquisitionHealth::Ok,
+		"The samples are processed in time.");
+	py_acquisition_health.value("Lagging", sv::devices::AcquisitionHealth::Lagging,
+		"Samples are dropped or the ingest queue is filling up.");
+
+	py::enum_<sv::devices::LoadWaveform> py_load_waveform(m, "LoadWaveform",
+		"Enum of all waveforms of the load generator device.");
+	py_load_waveform.value("Sine", sv::devices::LoadWaveform::Sine,
+		"Sine");
+	py_load_waveform.value("Square", sv::devices::LoadWaveform::Square,
+		"Square");
+	py_load_waveform.value("Triangle", sv::devices::LoadWaveform::Triangle,
+		"Triangle");
+	py_load_waveform.value("Sawtooth", sv::devices::LoadWaveform::Sawtooth,
+		"Sawtooth");
+	py_load_waveform.value("Noise", sv::devices::LoadWaveform::Noise,
+		"Uniformly distributed noise");
+
 	py::enum_<sv::data::Quantity> py_quantity(m, "Quantity", "Enum of all available quantities.");
 	py_quantity.value("Voltage", sv::data::Quantity::Voltage,
 		"Voltage");
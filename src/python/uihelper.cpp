@@ -31,6 +31,7 @@
 #include "src/ui/tabs/basetab.hpp"
 #include "src/ui/views/baseview.hpp"
 #include "src/ui/views/dataview.hpp"
+#include "src/ui/views/histogramview.hpp"
 #include "src/ui/views/plotview.hpp"
 #include "src/ui/views/powerpanelview.hpp"
 #include "src/ui/views/valuepanelview.hpp"
@@ -63,6 +64,13 @@ void UiHelper::add_control_view(std::string device_id, Qt::DockWidgetArea area,
 		area);
 }
 
+void UiHelper::add_histogram_view(std::string device_id,
+	Qt::DockWidgetArea area, shared_ptr<sv::data::AnalogTimeSignal> signal)
+{
+	auto tab = session_.main_window()->get_base_tab_from_device_id(device_id);
+	tab->add_view(new ui::views::HistogramView(session_, signal), area);
+}
+
 void UiHelper::add_plot_view(std::string device_id, Qt::DockWidgetArea area,
 	shared_ptr<sv::channels::BaseChannel> channel)
 {
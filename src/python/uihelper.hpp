@@ -69,6 +69,8 @@ public Q_SLOTS:
 		shared_ptr<sv::data::AnalogTimeSignal> signal);
 	void add_control_view(std::string device_id, Qt::DockWidgetArea area,
 		shared_ptr<sv::devices::Configurable> configurable);
+	void add_histogram_view(std::string device_id, Qt::DockWidgetArea area,
+		shared_ptr<sv::data::AnalogTimeSignal> signal);
 	void add_plot_view(std::string device_id, Qt::DockWidgetArea area,
 		shared_ptr<sv::channels::BaseChannel> channel);
 	void add_plot_view(std::string device_id, Qt::DockWidgetArea area,
@@ -55,6 +55,9 @@ UiProxy::UiProxy(Session &session, shared_ptr<UiHelper> ui_helper) :
 	connect(this, &UiProxy::add_control_view,
 		ui_helper_.get(), &UiHelper::add_control_view);
 
+	connect(this, &UiProxy::add_histogram_view,
+		ui_helper_.get(), &UiHelper::add_histogram_view);
+
 	connect(this, QOverload<std::string, Qt::DockWidgetArea, shared_ptr<sv::channels::BaseChannel>>::of(&UiProxy::add_plot_view),
 		ui_helper_.get(), QOverload<std::string, Qt::DockWidgetArea, shared_ptr<sv::channels::BaseChannel>>::of(&UiHelper::add_plot_view));
 	connect(this, QOverload<std::string, Qt::DockWidgetArea, shared_ptr<sv::data::AnalogTimeSignal>>::of(&UiProxy::add_plot_view),
@@ -99,6 +102,13 @@ string UiProxy::ui_add_control_view(string device_id, Qt::DockWidgetArea area,
 	return "control:" + configurable->name();
 }
 
+string UiProxy::ui_add_histogram_view(string device_id, Qt::DockWidgetArea area,
+	shared_ptr<data::AnalogTimeSignal> signal)
+{
+	Q_EMIT add_histogram_view(device_id, area, signal);
+	return "histogram:" + signal->name();
+}
+
 string UiProxy::ui_add_plot_view(string device_id, Qt::DockWidgetArea area,
 	shared_ptr<channels::BaseChannel> channel)
 {
@@ -21,6 +21,7 @@
 #include <list>
 #include <map>
 #include <memory>
+#include <stdexcept>
 #include <string>
 #include <utility>
 #include <vector>
@@ -31,8 +32,11 @@
 #include "config.h"
 #include "src/devicemanager.hpp"
 #include "src/util.hpp"
+#include "src/devices/acquisitionexecutor.hpp"
 #include "src/devices/basedevice.hpp"
 #include "src/devices/hardwaredevice.hpp"
+#include "src/devices/loadgeneratordevice.hpp"
+#include "src/devices/replaydevice.hpp"
 #include "src/devices/userdevice.hpp"
 #include "src/python/smuscriptrunner.hpp"
 
@@ -52,6 +56,7 @@ namespace sv {
 
 shared_ptr<sigrok::Context> Session::sr_context;
 double Session::session_start_timestamp = .0;
+shared_ptr<devices::AcquisitionExecutor> Session::acquisition_executor;
 
 Session::Session(DeviceManager &device_manager, MainWindow *main_window) :
 	device_manager_(device_manager),
@@ -153,6 +158,89 @@ shared_ptr<devices::UserDevice> Session::add_user_device()
 	return device;
 }
 
+shared_ptr<devices::ReplayDevice> Session::add_replay_device(
+	const string &file_name, double speed)
+{
+	auto device = make_shared<devices::ReplayDevice>(
+		sr_context, file_name, speed);
+	this->add_device(device);
+
+	return device;
+}
+
+shared_ptr<devices::LoadGeneratorDevice> Session::add_load_generator_device(
+	size_t channel_count, uint64_t samplerate, size_t packet_size,
+	devices::LoadWaveform waveform)
+{
+	auto device = make_shared<devices::LoadGeneratorDevice>(
+		sr_context, channel_count, samplerate, packet_size, waveform);
+	this->add_device(device);
+
+	return device;
+}
+
+shared_ptr<devices::LoadGeneratorDevice>
+	Session::add_load_generator_device_from_spec(const string &spec)
+{
+	size_t channel_count = 1;
+	uint64_t samplerate = 1000;
+	size_t packet_size = 100;
+	devices::LoadWaveform waveform = devices::LoadWaveform::Sine;
+
+	vector<string> options = util::split_string(spec, ":");
+	for (const auto &option : options) {
+		vector<string> key_value = util::split_string(option, "=");
+		if (key_value.size() != 2)
+			throw std::runtime_error("Invalid load generator option: " + option);
+		QString key = QString::fromStdString(key_value[0]);
+		QString value = QString::fromStdString(key_value[1]);
+
+		bool ok = true;
+		if (key == "channels") {
+			channel_count = value.toUInt(&ok);
+		}
+		else if (key == "samplerate") {
+			// Allow the suffixes k, M and G
+			double factor = 1;
+			if (value.endsWith("k"))
+				factor = 1e3;
+			else if (value.endsWith("M"))
+				factor = 1e6;
+			else if (value.endsWith("G"))
+				factor = 1e9;
+			if (factor > 1)
+				value.chop(1);
+			samplerate = (uint64_t)(value.toDouble(&ok) * factor);
+		}
+		else if (key == "packetsize") {
+			packet_size = value.toUInt(&ok);
+		}
+		else if (key == "waveform") {
+			if (value == "sine")
+				waveform = devices::LoadWaveform::Sine;
+			else if (value == "square")
+				waveform = devices::LoadWaveform::Square;
+			else if (value == "triangle")
+				waveform = devices::LoadWaveform::Triangle;
+			else if (value == "sawtooth")
+				waveform = devices::LoadWaveform::Sawtooth;
+			else if (value == "noise")
+				waveform = devices::LoadWaveform::Noise;
+			else
+				ok = false;
+		}
+		else {
+			ok = false;
+		}
+
+		if (!ok)
+			throw std::runtime_error("Invalid load generator option: " + option);
+	}
+
+	return add_load_generator_device(
+		channel_count, samplerate, packet_size, waveform);
+}
+
 void Session::remove_device(shared_ptr<devices::BaseDevice> device)
 {
 	if (device) {
@@ -43,9 +43,13 @@ class DeviceManager;
 class MainWindow;
 
 namespace devices {
+class AcquisitionExecutor;
 class BaseDevice;
 class HardwareDevice;
+class LoadGeneratorDevice;
+class ReplayDevice;
 class UserDevice;
+enum class LoadWaveform;
 }
 
 namespace python {
@@ -58,8 +62,13 @@ class Session : public QObject
 
 public:
 	static shared_ptr<sigrok::Context> sr_context;
-	// TODO: use std::chrono / std::time
+	/** Start of the session in seconds since the epoch, see SessionClock. */
 	static double session_start_timestamp;
+	/**
+	 * Shared acquisition executor for the device sessions. If not set, every
+	 * device runs its session in its own acquisition thread.
+	 */
+	static shared_ptr<devices::AcquisitionExecutor> acquisition_executor;
 
 public:
 	Session(DeviceManager &device_manager, MainWindow *main_window);
@@ -76,6 +85,28 @@ public:
 	list<shared_ptr<devices::HardwareDevice>> connect_device(string conn_string);
 	void add_device(shared_ptr<devices::BaseDevice> device);
 	shared_ptr<devices::UserDevice> add_user_device();
+	/**
+	 * Create a new replay device, that plays back the signals from a CSV
+	 * file exported by SmuView. Throws std::runtime_error if the file can't
+	 * be read.
+	 */
+	shared_ptr<devices::ReplayDevice> add_replay_device(
+		const string &file_name, double speed);
+	/**
+	 * Create a new load generator device, that generates samples at a high
+	 * rate for stress testing the data path.
+	 */
+	shared_ptr<devices::LoadGeneratorDevice> add_load_generator_device(
+		size_t channel_count, uint64_t samplerate, size_t packet_size,
+		devices::LoadWaveform waveform);
+	/**
+	 * Create a new load generator device from a spec of the form
+	 * "channels=4:samplerate=1M:packetsize=1000:waveform=sine", like it is
+	 * given with the "-g" command line option. Throws std::runtime_error if
+	 * the spec contains an invalid option.
+	 */
+	shared_ptr<devices::LoadGeneratorDevice> add_load_generator_device_from_spec(
+		const string &spec);
 	void remove_device(shared_ptr<devices::BaseDevice> device);
 
 	void load_init_file(const string &file_name, const string &format);
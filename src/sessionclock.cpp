@@ -0,0 +1,67 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2020 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <chrono>
+
+#include "sessionclock.hpp"
+
+namespace sv {
+
+namespace {
+
+struct anchor_t
+{
+	anchor_t() :
+		steady_time(std::chrono::steady_clock::now()),
+		wall_time(std::chrono::duration<double>(
+			std::chrono::system_clock::now().time_since_epoch()).count())
+	{
+	}
+
+	const std::chrono::steady_clock::time_point steady_time;
+	const double wall_time;
+};
+
+const anchor_t &anchor()
+{
+	// Initialized on first use, thread safe since C++11.
+	static const anchor_t anchor;
+	return anchor;
+}
+
+} // namespace
+
+void SessionClock::init()
+{
+	anchor();
+}
+
+double SessionClock::now()
+{
+	const anchor_t &a = anchor();
+	return a.wall_time + std::chrono::duration<double>(
+		std::chrono::steady_clock::now() - a.steady_time).count();
+}
+
+double SessionClock::start_timestamp()
+{
+	return anchor().wall_time;
+}
+
+} // namespace sv
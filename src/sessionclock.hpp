@@ -0,0 +1,58 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2020 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SESSIONCLOCK_HPP
+#define SESSIONCLOCK_HPP
+
+namespace sv {
+
+/**
+ * High resolution clock for the sample timestamps.
+ *
+ * The clock is anchored once to the wall clock and then advanced by the
+ * monotonic steady clock, so the timestamps have a sub-microsecond
+ * resolution and don't jump when the system time is adjusted. The
+ * timestamps are seconds since the epoch, like the wall clock.
+ */
+class SessionClock
+{
+
+public:
+	/**
+	 * Anchor the clock to the current wall time. Should be called once at
+	 * startup, before any device is opened. Further calls have no effect.
+	 */
+	static void init();
+
+	/**
+	 * Return the current timestamp in seconds since the epoch.
+	 */
+	static double now();
+
+	/**
+	 * Return the wall time in seconds since the epoch, the clock has been
+	 * anchored to.
+	 */
+	static double start_timestamp();
+
+};
+
+} // namespace sv
+
+#endif // SESSIONCLOCK_HPP
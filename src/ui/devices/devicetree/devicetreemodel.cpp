@@ -23,6 +23,7 @@
 #include <string>
 
 #include <QDebug>
+#include <QIcon>
 #include <QStandardItem>
 #include <QStandardItemModel>
 #include <QString>
@@ -30,10 +31,10 @@
 
 #include "devicetreemodel.hpp"
 #include "src/session.hpp"
-#include "src/data/properties/baseproperty.hpp"
 #include "src/data/basesignal.hpp"
 #include "src/devices/basedevice.hpp"
 #include "src/devices/configurable.hpp"
+#include "src/devices/deviceutil.hpp"
 #include "src/channels/basechannel.hpp"
 #include "src/ui/devices/devicetree/treeitem.hpp"
 
@@ -256,14 +257,14 @@ void DeviceTreeModel::add_configurable(
 		new_parent_item->sortChildren(0);
 	}
 
-	// ConfigKeys
-	for (const auto &property_pair : configurable->properties()) {
-		add_property(property_pair.second, conf_item);
+	// ConfigKeys. The properties are created on first use, so the tree only
+	// stores the config keys.
+	for (const auto &config_key : configurable->config_keys()) {
+		add_config_key(config_key, conf_item);
 	}
 }
 
-void DeviceTreeModel::add_property(
-	shared_ptr<sv::data::properties::BaseProperty> property,
+void DeviceTreeModel::add_config_key(sv::devices::ConfigKey config_key,
 	TreeItem *configurable_item)
 {
 	if (!show_configurable_)
@@ -271,15 +272,17 @@ void DeviceTreeModel::add_property(
 
 	std::lock_guard<std::recursive_mutex> lock(mutex_);
 
-	// Look for existing property
-	TreeItem *property_item = find_property(property, configurable_item);
+	// Look for existing config key
+	TreeItem *property_item = find_config_key(config_key, configurable_item);
 	if (!property_item) {
+		const QString name =
+			sv::devices::deviceutil::format_config_key(config_key);
 		beginInsertRows(configurable_item->index(),
 			configurable_item->rowCount(), configurable_item->rowCount()+1);
 		property_item = new TreeItem(TreeItemType::PropertyItem);
-		property_item->setText(property->display_name());
-		property_item->setData(QVariant::fromValue(property), DeviceTreeModel::DataRole);
-		property_item->setData(property->display_name(), DeviceTreeModel::SortRole);
+		property_item->setText(name);
+		property_item->setData((int)config_key, DeviceTreeModel::DataRole);
+		property_item->setData(name, DeviceTreeModel::SortRole);
 		property_item->setCheckable(is_signal_checkable_);
 		property_item->setEditable(false);
 		configurable_item->appendRow(property_item);
@@ -304,6 +307,47 @@ TreeItem *DeviceTreeModel::find_device(
 	return nullptr;
 }
 
+void DeviceTreeModel::update_device_health()
+{
+	std::lock_guard<std::recursive_mutex> lock(mutex_);
+
+	for (int i=0; i<invisibleRootItem()->rowCount(); ++i) {
+		auto child = invisibleRootItem()->child(i);
+		if (child->type() != (int)TreeItemType::DeviceItem)
+			continue;
+
+		auto device = child->data(DeviceTreeModel::DataRole).
+			value<shared_ptr<sv::devices::BaseDevice>>();
+		if (!device)
+			continue;
+
+		auto stats = device->acquisition_statistics();
+		switch (device->acquisition_health()) {
+		case sv::devices::AcquisitionHealth::Ok:
+			child->setIcon(QIcon(":/icons/status-green.svg"));
+			break;
+		case sv::devices::AcquisitionHealth::Lagging:
+			child->setIcon(QIcon(":/icons/status-red.svg"));
+			break;
+		case sv::devices::AcquisitionHealth::Idle:
+		default:
+			child->setIcon(QIcon(":/icons/smuview.png"));
+			break;
+		}
+
+		if (stats.packet_count == 0) {
+			child->setToolTip(tr("No samples received"));
+			continue;
+		}
+		child->setToolTip(tr("%1 samples/s, %2 packets/s\n"
+			"Queue: %3 / %4\nDropped samples: %5").
+			arg(stats.sample_rate, 0, 'f', 0).
+			arg(stats.packet_rate, 0, 'f', 1).
+			arg(stats.queue_depth).arg(stats.queue_capacity).
+			arg(stats.dropped_sample_count));
+	}
+}
+
 TreeItem *DeviceTreeModel::find_channel_group(string channel_group_name,
 	TreeItem *parent_item) const
 {
@@ -388,17 +432,15 @@ TreeItem *DeviceTreeModel::find_configurable(
 	return nullptr;
 }
 
-TreeItem *DeviceTreeModel::find_property(
-	shared_ptr<sv::data::properties::BaseProperty> property,
-	TreeItem *configurable_item) const
+TreeItem *DeviceTreeModel::find_config_key(
+	sv::devices::ConfigKey config_key, TreeItem *configurable_item) const
 {
 	for (int i=0; i<configurable_item->rowCount(); ++i) {
 		auto child = configurable_item->child(i);
 		if (child->type() != (int)TreeItemType::PropertyItem)
 			continue;
 
-		if (property.get() == child->data(DeviceTreeModel::DataRole).
-				value<shared_ptr<sv::data::properties::BaseProperty>>().get())
+		if ((int)config_key == child->data(DeviceTreeModel::DataRole).toInt())
 			return (TreeItem *)child;
 	}
 	return nullptr;
@@ -43,13 +43,11 @@ class BaseChannel;
 }
 namespace data {
 class BaseSignal;
-namespace properties {
-class BaseProperty;
-}
 }
 namespace devices {
 class BaseDevice;
 class Configurable;
+enum class ConfigKey;
 }
 
 namespace ui {
@@ -71,6 +69,12 @@ public:
 
 	TreeItem *find_device(shared_ptr<sv::devices::BaseDevice> device) const;
 
+	/**
+	 * Update the icons and tool tips of the device items with the current
+	 * acquisition health of the devices.
+	 */
+	void update_device_health();
+
 	const static int DataRole = Qt::UserRole + 1;
 	const static int SortRole = Qt::UserRole + 2;
 
@@ -86,7 +90,7 @@ private:
 		TreeItem *parent_item);
 	void add_configurable(shared_ptr<sv::devices::Configurable> configurable,
 		TreeItem *device_item);
-	void add_property(shared_ptr<sv::data::properties::BaseProperty> property,
+	void add_config_key(sv::devices::ConfigKey config_key,
 		TreeItem *configurable_item);
 
 	TreeItem *find_channel_group(string channel_group_name,
@@ -98,8 +102,7 @@ private:
 	TreeItem *find_configurable(
 		shared_ptr<sv::devices::Configurable> configurable,
 		TreeItem *device_item) const;
-	TreeItem *find_property(
-		shared_ptr<sv::data::properties::BaseProperty> property,
+	TreeItem *find_config_key(sv::devices::ConfigKey config_key,
 		TreeItem *configurable_item) const;
 
 	const Session &session_;
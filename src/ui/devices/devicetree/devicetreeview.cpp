@@ -192,6 +192,11 @@ void DeviceTreeView::expand_device(shared_ptr<sv::devices::BaseDevice> device)
 	this->expand_recursive(item);
 }
 
+void DeviceTreeView::update_device_health()
+{
+	tree_model_->update_device_health();
+}
+
 void DeviceTreeView::setup_ui()
 {
 	tree_model_ = new DeviceTreeModel(session_,
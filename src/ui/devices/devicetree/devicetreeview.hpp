@@ -74,6 +74,8 @@ public:
 
 	void expand_device(shared_ptr<sv::devices::BaseDevice> device);
 
+	void update_device_health();
+
 private:
 	void setup_ui();
 	void expand_recursive(QStandardItem *item);
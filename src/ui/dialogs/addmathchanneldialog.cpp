@@ -37,14 +37,20 @@
 #include "addmathchanneldialog.hpp"
 #include "src/channels/addscchannel.hpp"
 #include "src/channels/basechannel.hpp"
+#include "src/channels/decimatechannel.hpp"
 #include "src/channels/dividechannel.hpp"
+#include "src/channels/eventdetectorchannel.hpp"
+#include "src/channels/fftchannel.hpp"
 #include "src/channels/integratechannel.hpp"
 #include "src/channels/mathchannel.hpp"
 #include "src/channels/movingavgchannel.hpp"
 #include "src/channels/multiplysfchannel.hpp"
 #include "src/channels/multiplysschannel.hpp"
+#include "src/channels/resamplechannel.hpp"
+#include "src/channels/windowedminmaxchannel.hpp"
 #include "src/data/analogtimesignal.hpp"
 #include "src/data/datautil.hpp"
+#include "src/data/fft.hpp"
 #include "src/devices/basedevice.hpp"
 #include "src/ui/data/quantitycombobox.hpp"
 #include "src/ui/data/quantityflagslist.hpp"
@@ -127,6 +133,11 @@ void AddMathChannelDialog::setup_ui()
 	this->setup_ui_add_signal_tab();
 	this->setup_ui_integrate_signal_tab();
 	this->setup_ui_movingavg_signal_tab();
+	this->setup_ui_fft_signal_tab();
+	this->setup_ui_resample_signal_tab();
+	this->setup_ui_decimate_signal_tab();
+	this->setup_ui_windowed_minmax_signal_tab();
+	this->setup_ui_event_detector_signal_tab();
 	tab_widget_->setCurrentIndex(0);
 	main_layout->addWidget(tab_widget_);
 
@@ -286,6 +297,184 @@ void AddMathChannelDialog::setup_ui_movingavg_signal_tab()
 	tab_widget_->addTab(widget, title);
 }
 
+void AddMathChannelDialog::setup_ui_fft_signal_tab()
+{
+	QString title(tr("Spectrum"));
+
+	QWidget *widget = new QWidget();
+	QVBoxLayout *layout = new QVBoxLayout();
+
+	QGroupBox *signal_group = new QGroupBox(tr("Signal"));
+	QVBoxLayout *s_layout = new QVBoxLayout();
+	fft_signal_ = new ui::devices::SelectSignalWidget(session_);
+	fft_signal_->select_device(device_);
+	s_layout->addWidget(fft_signal_);
+	signal_group->setLayout(s_layout);
+	layout->addWidget(signal_group);
+
+	QFormLayout *fft_layout = new QFormLayout();
+	fft_size_box_ = new QComboBox();
+	for (int size=64; size<=65536; size*=2)
+		fft_size_box_->addItem(QString::number(size), QVariant(size));
+	fft_size_box_->setCurrentIndex(fft_size_box_->findData(QVariant(1024)));
+	fft_layout->addRow(tr("FFT size"), fft_size_box_);
+	fft_overlap_box_ = new QSpinBox();
+	fft_overlap_box_->setRange(0, 90);
+	fft_overlap_box_->setSingleStep(25);
+	fft_overlap_box_->setValue(50);
+	fft_overlap_box_->setSuffix(" %");
+	fft_layout->addRow(tr("Overlap"), fft_overlap_box_);
+	fft_window_box_ = new QComboBox();
+	fft_window_box_->addItem(tr("Hann"),
+		QVariant::fromValue((int)sv::data::WindowFunction::Hann));
+	fft_window_box_->addItem(tr("Blackman"),
+		QVariant::fromValue((int)sv::data::WindowFunction::Blackman));
+	fft_layout->addRow(tr("Window"), fft_window_box_);
+	layout->addLayout(fft_layout);
+
+	widget->setLayout(layout);
+	tab_widget_->addTab(widget, title);
+}
+
+void AddMathChannelDialog::setup_ui_resample_signal_tab()
+{
+	QString title(tr("Resample"));
+
+	QWidget *widget = new QWidget();
+	QVBoxLayout *layout = new QVBoxLayout();
+
+	QGroupBox *signal_group = new QGroupBox(tr("Signal"));
+	QVBoxLayout *s_layout = new QVBoxLayout();
+	rs_signal_ = new ui::devices::SelectSignalWidget(session_);
+	rs_signal_->select_device(device_);
+	s_layout->addWidget(rs_signal_);
+	signal_group->setLayout(s_layout);
+	layout->addWidget(signal_group);
+
+	QFormLayout *rs_layout = new QFormLayout();
+	rs_rate_edit_ = new QLineEdit();
+	rs_layout->addRow(tr("Rate [Hz]"), rs_rate_edit_);
+	rs_interpolation_box_ = new QComboBox();
+	rs_interpolation_box_->addItem(tr("Hold"),
+		QVariant::fromValue((int)channels::ResampleInterpolation::Hold));
+	rs_interpolation_box_->addItem(tr("Linear"),
+		QVariant::fromValue((int)channels::ResampleInterpolation::Linear));
+	rs_interpolation_box_->addItem(tr("Cubic"),
+		QVariant::fromValue((int)channels::ResampleInterpolation::Cubic));
+	rs_interpolation_box_->setCurrentIndex(1);
+	rs_layout->addRow(tr("Interpolation"), rs_interpolation_box_);
+	layout->addLayout(rs_layout);
+
+	widget->setLayout(layout);
+	tab_widget_->addTab(widget, title);
+}
+
+void AddMathChannelDialog::setup_ui_decimate_signal_tab()
+{
+	QString title(tr("Decimate"));
+
+	QWidget *widget = new QWidget();
+	QVBoxLayout *layout = new QVBoxLayout();
+
+	QGroupBox *signal_group = new QGroupBox(tr("Signal"));
+	QVBoxLayout *s_layout = new QVBoxLayout();
+	dec_signal_ = new ui::devices::SelectSignalWidget(session_);
+	dec_signal_->select_device(device_);
+	s_layout->addWidget(dec_signal_);
+	signal_group->setLayout(s_layout);
+	layout->addWidget(signal_group);
+
+	QFormLayout *dec_layout = new QFormLayout();
+	dec_factor_box_ = new QSpinBox();
+	dec_factor_box_->setRange(2, 1000000);
+	dec_factor_box_->setValue(10);
+	dec_layout->addRow(tr("Sample count"), dec_factor_box_);
+	dec_mode_box_ = new QComboBox();
+	dec_mode_box_->addItem(tr("Mean"),
+		QVariant::fromValue((int)channels::DecimationMode::Mean));
+	dec_mode_box_->addItem(tr("Min/Max"),
+		QVariant::fromValue((int)channels::DecimationMode::MinMax));
+	dec_mode_box_->addItem(tr("Last"),
+		QVariant::fromValue((int)channels::DecimationMode::Last));
+	dec_layout->addRow(tr("Mode"), dec_mode_box_);
+	layout->addLayout(dec_layout);
+
+	widget->setLayout(layout);
+	tab_widget_->addTab(widget, title);
+}
+
+void AddMathChannelDialog::setup_ui_windowed_minmax_signal_tab()
+{
+	QString title(tr("Windowed Min/Max"));
+
+	QWidget *widget = new QWidget();
+	QVBoxLayout *layout = new QVBoxLayout();
+
+	QGroupBox *signal_group = new QGroupBox(tr("Signal"));
+	QVBoxLayout *s_layout = new QVBoxLayout();
+	wmm_signal_ = new ui::devices::SelectSignalWidget(session_);
+	wmm_signal_->select_device(device_);
+	s_layout->addWidget(wmm_signal_);
+	signal_group->setLayout(s_layout);
+	layout->addWidget(signal_group);
+
+	QFormLayout *wmm_layout = new QFormLayout();
+	wmm_function_box_ = new QComboBox();
+	wmm_function_box_->addItem(tr("Maximum"),
+		QVariant::fromValue((int)channels::WindowedFunction::Max));
+	wmm_function_box_->addItem(tr("Minimum"),
+		QVariant::fromValue((int)channels::WindowedFunction::Min));
+	wmm_function_box_->addItem(tr("Peak-to-peak"),
+		QVariant::fromValue((int)channels::WindowedFunction::PeakToPeak));
+	wmm_layout->addRow(tr("Function"), wmm_function_box_);
+	wmm_window_type_box_ = new QComboBox();
+	wmm_window_type_box_->addItem(tr("Sample count"),
+		QVariant::fromValue((int)channels::WindowType::SampleCount));
+	wmm_window_type_box_->addItem(tr("Time span [s]"),
+		QVariant::fromValue((int)channels::WindowType::TimeSpan));
+	wmm_layout->addRow(tr("Window"), wmm_window_type_box_);
+	wmm_window_size_edit_ = new QLineEdit();
+	wmm_layout->addRow(tr("Window size"), wmm_window_size_edit_);
+	layout->addLayout(wmm_layout);
+
+	widget->setLayout(layout);
+	tab_widget_->addTab(widget, title);
+}
+
+void AddMathChannelDialog::setup_ui_event_detector_signal_tab()
+{
+	QString title(tr("Events"));
+
+	QWidget *widget = new QWidget();
+	QVBoxLayout *layout = new QVBoxLayout();
+
+	QGroupBox *signal_group = new QGroupBox(tr("Signal"));
+	QVBoxLayout *s_layout = new QVBoxLayout();
+	ev_signal_ = new ui::devices::SelectSignalWidget(session_);
+	ev_signal_->select_device(device_);
+	s_layout->addWidget(ev_signal_);
+	signal_group->setLayout(s_layout);
+	layout->addWidget(signal_group);
+
+	QFormLayout *ev_layout = new QFormLayout();
+	ev_level_edit_ = new QLineEdit();
+	ev_layout->addRow(tr("Level"), ev_level_edit_);
+	ev_hysteresis_edit_ = new QLineEdit(QString("0"));
+	ev_layout->addRow(tr("Hysteresis"), ev_hysteresis_edit_);
+	ev_edge_box_ = new QComboBox();
+	ev_edge_box_->addItem(tr("Rising"),
+		QVariant::fromValue((int)channels::EventEdge::Rising));
+	ev_edge_box_->addItem(tr("Falling"),
+		QVariant::fromValue((int)channels::EventEdge::Falling));
+	ev_edge_box_->addItem(tr("Both"),
+		QVariant::fromValue((int)channels::EventEdge::Both));
+	ev_layout->addRow(tr("Edge"), ev_edge_box_);
+	layout->addLayout(ev_layout);
+
+	widget->setLayout(layout);
+	tab_widget_->addTab(widget, title);
+}
+
 shared_ptr<channels::MathChannel> AddMathChannelDialog::channel() const
 {
 	return channel_;
@@ -489,6 +678,155 @@ void AddMathChannelDialog::accept()
 				signal->signal_start_timestamp());
 		}
 		break;
+	case 6: {
+			if (fft_signal_->selected_signal() == nullptr) {
+				QMessageBox::warning(this,
+					tr("Signal missing"),
+					tr("Please choose a signal for the spectrum."),
+					QMessageBox::Ok);
+				return;
+			}
+			auto signal = static_pointer_cast<sv::data::AnalogTimeSignal>(
+				fft_signal_->selected_signal());
+
+			size_t fft_size = fft_size_box_->currentData().toUInt();
+			size_t overlap = fft_size * fft_overlap_box_->value() / 100;
+			auto window = (sv::data::WindowFunction)
+				fft_window_box_->currentData().toInt();
+
+			channel_ = make_shared<channels::FftChannel>(
+				quantity, quantity_flags, unit,
+				signal, fft_size, overlap, window,
+				device, channel_group_names, name_edit_->text().toStdString(),
+				signal->signal_start_timestamp());
+		}
+		break;
+	case 7: {
+			if (rs_signal_->selected_signal() == nullptr) {
+				QMessageBox::warning(this,
+					tr("Signal missing"),
+					tr("Please choose a signal for the resampling."),
+					QMessageBox::Ok);
+				return;
+			}
+			auto signal = static_pointer_cast<sv::data::AnalogTimeSignal>(
+				rs_signal_->selected_signal());
+
+			bool ok;
+			double rate = QString(rs_rate_edit_->text()).toDouble(&ok);
+			if (!ok || rate <= 0) {
+				QMessageBox::warning(this,
+					tr("Rate not valid"),
+					tr("Please enter a positive number as rate for the resampling."),
+					QMessageBox::Ok);
+				return;
+			}
+
+			auto interpolation = (channels::ResampleInterpolation)
+				rs_interpolation_box_->currentData().toInt();
+
+			channel_ = make_shared<channels::ResampleChannel>(
+				quantity, quantity_flags, unit,
+				signal, rate, interpolation,
+				device, channel_group_names, name_edit_->text().toStdString(),
+				signal->signal_start_timestamp());
+		}
+		break;
+	case 8: {
+			if (dec_signal_->selected_signal() == nullptr) {
+				QMessageBox::warning(this,
+					tr("Signal missing"),
+					tr("Please choose a signal for the decimation."),
+					QMessageBox::Ok);
+				return;
+			}
+			auto signal = static_pointer_cast<sv::data::AnalogTimeSignal>(
+				dec_signal_->selected_signal());
+
+			size_t factor = dec_factor_box_->value();
+			auto mode = (channels::DecimationMode)
+				dec_mode_box_->currentData().toInt();
+
+			channel_ = make_shared<channels::DecimateChannel>(
+				quantity, quantity_flags, unit,
+				signal, factor, mode,
+				device, channel_group_names, name_edit_->text().toStdString(),
+				signal->signal_start_timestamp());
+		}
+		break;
+	case 9: {
+			if (wmm_signal_->selected_signal() == nullptr) {
+				QMessageBox::warning(this,
+					tr("Signal missing"),
+					tr("Please choose a signal for the windowed min/max."),
+					QMessageBox::Ok);
+				return;
+			}
+			auto signal = static_pointer_cast<sv::data::AnalogTimeSignal>(
+				wmm_signal_->selected_signal());
+
+			bool ok;
+			double window_size =
+				QString(wmm_window_size_edit_->text()).toDouble(&ok);
+			if (!ok || window_size <= 0) {
+				QMessageBox::warning(this,
+					tr("Window size not valid"),
+					tr("Please enter a positive number as window size."),
+					QMessageBox::Ok);
+				return;
+			}
+
+			auto function = (channels::WindowedFunction)
+				wmm_function_box_->currentData().toInt();
+			auto window_type = (channels::WindowType)
+				wmm_window_type_box_->currentData().toInt();
+
+			channel_ = make_shared<channels::WindowedMinMaxChannel>(
+				quantity, quantity_flags, unit,
+				signal, function, window_type, window_size,
+				device, channel_group_names, name_edit_->text().toStdString(),
+				signal->signal_start_timestamp());
+		}
+		break;
+	case 10: {
+			if (ev_signal_->selected_signal() == nullptr) {
+				QMessageBox::warning(this,
+					tr("Signal missing"),
+					tr("Please choose a signal for the event detection."),
+					QMessageBox::Ok);
+				return;
+			}
+			auto signal = static_pointer_cast<sv::data::AnalogTimeSignal>(
+				ev_signal_->selected_signal());
+
+			bool ok;
+			double level = QString(ev_level_edit_->text()).toDouble(&ok);
+			if (!ok) {
+				QMessageBox::warning(this,
+					tr("Level not valid"),
+					tr("Please enter a valid number as level."),
+					QMessageBox::Ok);
+				return;
+			}
+			double hysteresis =
+				QString(ev_hysteresis_edit_->text()).toDouble(&ok);
+			if (!ok || hysteresis < 0) {
+				QMessageBox::warning(this,
+					tr("Hysteresis not valid"),
+					tr("Please enter a positive number (or 0) as hysteresis."),
+					QMessageBox::Ok);
+				return;
+			}
+
+			auto edge = (channels::EventEdge)ev_edge_box_->currentData().toInt();
+
+			channel_ = make_shared<channels::EventDetectorChannel>(
+				quantity, quantity_flags, unit,
+				signal, level, hysteresis, edge,
+				device, channel_group_names, name_edit_->text().toStdString(),
+				signal->signal_start_timestamp());
+		}
+		break;
 	default:
 		break;
 	}
@@ -22,6 +22,7 @@
 
 #include <memory>
 
+#include <QComboBox>
 #include <QDialog>
 #include <QDialogButtonBox>
 #include <QLineEdit>
@@ -77,6 +78,11 @@ private:
 	void setup_ui_add_signal_tab();
 	void setup_ui_integrate_signal_tab();
 	void setup_ui_movingavg_signal_tab();
+	void setup_ui_fft_signal_tab();
+	void setup_ui_resample_signal_tab();
+	void setup_ui_decimate_signal_tab();
+	void setup_ui_windowed_minmax_signal_tab();
+	void setup_ui_event_detector_signal_tab();
 
 	const Session &session_;
 	shared_ptr<sv::devices::BaseDevice> device_;
@@ -100,6 +106,24 @@ private:
 	ui::devices::SelectSignalWidget *i_s_signal_;
 	ui::devices::SelectSignalWidget *ma_signal_;
 	QSpinBox *ma_num_samples_box_;
+	ui::devices::SelectSignalWidget *fft_signal_;
+	QComboBox *fft_size_box_;
+	QSpinBox *fft_overlap_box_;
+	QComboBox *fft_window_box_;
+	ui::devices::SelectSignalWidget *rs_signal_;
+	QLineEdit *rs_rate_edit_;
+	QComboBox *rs_interpolation_box_;
+	ui::devices::SelectSignalWidget *dec_signal_;
+	QSpinBox *dec_factor_box_;
+	QComboBox *dec_mode_box_;
+	ui::devices::SelectSignalWidget *wmm_signal_;
+	QComboBox *wmm_function_box_;
+	QComboBox *wmm_window_type_box_;
+	QLineEdit *wmm_window_size_edit_;
+	ui::devices::SelectSignalWidget *ev_signal_;
+	QLineEdit *ev_level_edit_;
+	QLineEdit *ev_hysteresis_edit_;
+	QComboBox *ev_edge_box_;
 	QDialogButtonBox *button_box_;
 
 public Q_SLOTS:
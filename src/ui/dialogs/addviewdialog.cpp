@@ -29,6 +29,7 @@
 
 #include "addviewdialog.hpp"
 #include "src/channels/basechannel.hpp"
+#include "src/channels/fftchannel.hpp"
 #include "src/data/analogtimesignal.hpp"
 #include "src/data/properties/baseproperty.hpp"
 #include "src/data/properties/doubleproperty.hpp"
@@ -41,12 +42,15 @@
 #include "src/ui/devices/devicetree/devicetreeview.hpp"
 #include "src/ui/views/baseview.hpp"
 #include "src/ui/views/dataview.hpp"
+#include "src/ui/views/histogramview.hpp"
 #include "src/ui/views/plotview.hpp"
 #include "src/ui/views/powerpanelview.hpp"
 #include "src/ui/views/sequenceoutputview.hpp"
+#include "src/ui/views/spectrogramview.hpp"
 #include "src/ui/views/valuepanelview.hpp"
 #include "src/ui/views/viewhelper.hpp"
 
+using std::dynamic_pointer_cast;
 using std::set;
 using std::static_pointer_cast;
 
@@ -87,6 +91,8 @@ void AddViewDialog::setup_ui()
 	this->setup_ui_xy_plot_tab();
 	this->setup_ui_data_table_tab();
 	this->setup_ui_power_panel_tab();
+	this->setup_ui_spectrogram_tab();
+	this->setup_ui_histogram_tab();
 	tab_widget_->setCurrentIndex(selected_tab_);
 	main_layout->addWidget(tab_widget_);
 
@@ -228,6 +234,39 @@ void AddViewDialog::setup_ui_power_panel_tab()
 	tab_widget_->addTab(pp_widget, title);
 }
 
+void AddViewDialog::setup_ui_spectrogram_tab()
+{
+	QString title(tr("Spectrogram"));
+	QWidget *spectrogram_widget = new QWidget();
+	QVBoxLayout *layout = new QVBoxLayout();
+	spectrogram_widget->setLayout(layout);
+
+	// Only FFT channels provide spectra, other channels are ignored.
+	spectrogram_channel_tree_ = new ui::devices::devicetree::DeviceTreeView(
+		session_, false, false, true, false, false, false, false, false);
+	spectrogram_channel_tree_->expand_device(device_);
+
+	layout->addWidget(spectrogram_channel_tree_);
+
+	tab_widget_->addTab(spectrogram_widget, title);
+}
+
+void AddViewDialog::setup_ui_histogram_tab()
+{
+	QString title(tr("Histogram"));
+	QWidget *histogram_widget = new QWidget();
+	QVBoxLayout *layout = new QVBoxLayout();
+	histogram_widget->setLayout(layout);
+
+	histogram_signal_tree_ = new ui::devices::devicetree::DeviceTreeView(
+		session_, false, false, false, true, false, false, false, false);
+	histogram_signal_tree_->expand_device(device_);
+
+	layout->addWidget(histogram_signal_tree_);
+
+	tab_widget_->addTab(histogram_widget, title);
+}
+
 vector<ui::views::BaseView *> AddViewDialog::views()
 {
 	return views_;
@@ -314,6 +353,21 @@ void AddViewDialog::accept()
 			}
 		}
 		break;
+	case 7:
+		// Add spectrogram view
+		for (const auto &channel : spectrogram_channel_tree_->checked_channels()) {
+			auto fft_channel = dynamic_pointer_cast<channels::FftChannel>(channel);
+			if (fft_channel)
+				views_.push_back(new ui::views::SpectrogramView(session_, fft_channel));
+		}
+		break;
+	case 8:
+		// Add histogram view
+		for (const auto &signal : histogram_signal_tree_->checked_signals()) {
+			auto a_signal = static_pointer_cast<data::AnalogTimeSignal>(signal);
+			views_.push_back(new ui::views::HistogramView(session_, a_signal));
+		}
+		break;
 	default:
 		break;
 	}
@@ -66,6 +66,7 @@ ConnectDialog::ConnectDialog(sv::DeviceManager &device_manager,
 	serial_devices_(&form_),
 	scan_button_(tr("&Scan for devices using driver above"), this),
 	device_list_(this),
+	is_manual_scan_(false),
 	button_box_(QDialogButtonBox::Ok | QDialogButtonBox::Cancel,
 		Qt::Horizontal, this)
 {
@@ -176,6 +177,13 @@ ConnectDialog::ConnectDialog(sv::DeviceManager &device_manager,
 
 	// Initially populate serials for current selected device
 	on_driver_selected(drivers_.currentIndex());
+
+	// Show the devices of the background scan, also the ones that are
+	// found while the dialog is open, until a driver is scanned manually.
+	for (const auto &device : device_manager_.devices())
+		add_device(device);
+	connect(&device_manager_, &DeviceManager::device_found,
+		this, &ConnectDialog::on_device_found);
 }
 
 ConnectDialog::~ConnectDialog(){
@@ -338,23 +346,38 @@ void ConnectDialog::on_scan_pressed()
 	const list<shared_ptr<HardwareDevice>> devices =
 		device_manager_.driver_scan(driver, drvopts);
 
-	for (const auto &device : devices) {
-		assert(device);
-
-		QString text = device->display_name(device_manager_);
-		text += QString(" with %1 channels").arg(
-			device->sr_device()->channels().size());
-
-		QListWidgetItem *const item = new QListWidgetItem(text,
-			&device_list_);
-		item->setData(Qt::UserRole, qVariantFromValue(device));
-		device_list_.addItem(item);
-	}
+	is_manual_scan_ = true;
+	for (const auto &device : devices)
+		add_device(device);
 
 	device_list_.setCurrentRow(0);
 	button_box_.button(QDialogButtonBox::Ok)->setDisabled(device_list_.count() == 0);
 }
 
+void ConnectDialog::add_device(shared_ptr<HardwareDevice> device)
+{
+	assert(device);
+
+	QString text = device->display_name(device_manager_);
+	text += QString(" with %1 channels").arg(
+		device->sr_device()->channels().size());
+
+	QListWidgetItem *const item = new QListWidgetItem(text,
+		&device_list_);
+	item->setData(Qt::UserRole, qVariantFromValue(device));
+	device_list_.addItem(item);
+
+	if (!device_list_.currentItem())
+		device_list_.setCurrentRow(0);
+	button_box_.button(QDialogButtonBox::Ok)->setDisabled(false);
+}
+
+void ConnectDialog::on_device_found(shared_ptr<HardwareDevice> device)
+{
+	if (!is_manual_scan_)
+		add_device(device);
+}
+
 void ConnectDialog::on_driver_selected(int index)
 {
 	shared_ptr<Driver> driver =
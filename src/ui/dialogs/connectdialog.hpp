@@ -78,6 +78,7 @@ private:
 	void populate_serials_thread_proc(shared_ptr<sigrok::Driver> driver);
 	void check_available_libs();
 	void unset_connection();
+	void add_device(shared_ptr<sv::devices::HardwareDevice> device);
 
 private Q_SLOTS:
 	void on_driver_selected(int index);
@@ -86,6 +87,7 @@ private Q_SLOTS:
 	void on_gpib_toggled(bool checked);
 	void on_scan_pressed();
 	void on_populate_serials_done(std::map<std::string, std::string> serials);
+	void on_device_found(shared_ptr<sv::devices::HardwareDevice> device);
 
 private:
 	sv::DeviceManager &device_manager_;
@@ -117,6 +119,8 @@ private:
 
 	QPushButton scan_button_;
 	QListWidget device_list_;
+	/** The device list shows the result of a manual scan */
+	bool is_manual_scan_;
 
 	QDialogButtonBox button_box_;
 
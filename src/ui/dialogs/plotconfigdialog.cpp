@@ -17,8 +17,10 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <cmath>
 #include <map>
 
+#include <QCheckBox>
 #include <QComboBox>
 #include <QDebug>
 #include <QDialog>
@@ -26,6 +28,7 @@
 #include <QFormLayout>
 #include <QIcon>
 #include <QLineEdit>
+#include <QSpinBox>
 #include <QString>
 #include <QTabWidget>
 #include <QVariant>
@@ -35,6 +38,7 @@
 #include "plotconfigdialog.hpp"
 #include "src/ui/views/plotview.hpp"
 #include "src/ui/widgets/plot/plot.hpp"
+#include "src/ui/widgets/plot/plotscheduler.hpp"
 
 Q_DECLARE_METATYPE(sv::ui::widgets::plot::PlotUpdateMode)
 
@@ -68,6 +72,7 @@ void PlotConfigDialog::setup_ui()
 		this->setup_ui_plot_mode_tab();
 	}
 	this->setup_ui_markers_tab();
+	this->setup_ui_rendering_tab();
 	//this->setup_ui_style_tab();
 	tab_widget_->setCurrentIndex(0);
 	main_layout->addWidget(tab_widget_);
@@ -113,6 +118,11 @@ void PlotConfigDialog::setup_ui_plot_mode_tab()
 	add_time_edit_->setText(QString("%1").arg(plot_->add_time(), 0, 'f'));
 	layout->addRow(tr("Add time"), add_time_edit_);
 
+	visible_y_autoscale_checkbox_ = new QCheckBox(
+		tr("Scale y axis to the visible samples"));
+	visible_y_autoscale_checkbox_->setChecked(plot_->visible_y_autoscale());
+	layout->addRow(visible_y_autoscale_checkbox_);
+
 	switch (plot_->update_mode()) {
 	case widgets::plot::PlotUpdateMode::Additive:
 		setup_ui_additive();
@@ -169,6 +179,32 @@ void PlotConfigDialog::setup_ui_markers_tab()
 	tab_widget_->addTab(widget, title);
 }
 
+void PlotConfigDialog::setup_ui_rendering_tab()
+{
+	QString title(tr("Rendering"));
+
+	QWidget *widget = new QWidget();
+	QFormLayout *layout = new QFormLayout();
+
+	background_rendering_checkbox_ = new QCheckBox(
+		tr("Render curves in a background thread"));
+	background_rendering_checkbox_->setChecked(plot_->background_rendering());
+	layout->addRow(background_rendering_checkbox_);
+
+	// The frame rate is shared by all plots.
+	frame_rate_spinbox_ = new QSpinBox();
+	frame_rate_spinbox_->setRange(1, 60);
+	frame_rate_spinbox_->setSuffix(tr(" fps"));
+	frame_rate_spinbox_->setValue((int)std::lround(
+		widgets::plot::PlotScheduler::instance()->target_frame_rate()));
+	frame_rate_spinbox_->setToolTip(
+		tr("Maximum frame rate of all plots. Under load the frame rate is reduced automatically."));
+	layout->addRow(tr("Max. frame rate"), frame_rate_spinbox_);
+
+	widget->setLayout(layout);
+	tab_widget_->addTab(widget, title);
+}
+
 void PlotConfigDialog::setup_ui_style_tab()
 {
 	QString title(tr("Style"));
@@ -227,10 +263,16 @@ void PlotConfigDialog::accept()
 		if (update_mode == widgets::plot::PlotUpdateMode::Additive ||
 				update_mode == widgets::plot::PlotUpdateMode::Rolling)
 			plot_->set_add_time(add_time_edit_->text().toDouble());
+		plot_->set_visible_y_autoscale(
+			visible_y_autoscale_checkbox_->isChecked());
 	}
 
 	plot_->set_markers_label_alignment(
 		markers_box_pos_combobox_->currentData().toInt());
+	plot_->set_background_rendering(
+		background_rendering_checkbox_->isChecked());
+	widgets::plot::PlotScheduler::instance()->set_target_frame_rate(
+		frame_rate_spinbox_->value());
 
 	QDialog::accept();
 }
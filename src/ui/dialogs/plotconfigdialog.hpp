@@ -22,10 +22,12 @@
 
 #include <map>
 
+#include <QCheckBox>
 #include <QComboBox>
 #include <QDialog>
 #include <QDialogButtonBox>
 #include <QLineEdit>
+#include <QSpinBox>
 #include <QString>
 #include <QTabWidget>
 #include <QWidget>
@@ -49,6 +51,7 @@ private:
 	void setup_ui();
 	void setup_ui_plot_mode_tab();
 	void setup_ui_markers_tab();
+	void setup_ui_rendering_tab();
 	void setup_ui_style_tab();
 	void setup_ui_additive();
 	void setup_ui_rolling();
@@ -60,7 +63,10 @@ private:
 	QComboBox *plot_update_mode_combobox_;
 	QLineEdit *time_span_edit_;
 	QLineEdit *add_time_edit_;
+	QCheckBox *visible_y_autoscale_checkbox_;
 	QComboBox *markers_box_pos_combobox_;
+	QCheckBox *background_rendering_checkbox_;
+	QSpinBox *frame_rate_spinbox_;
 	QDialogButtonBox *button_box_;
 
 public Q_SLOTS:
@@ -18,10 +18,13 @@
  */
 
 #include <memory>
+#include <stdexcept>
 
 #include <QAction>
 #include <QDebug>
+#include <QFileDialog>
 #include <QMessageBox>
+#include <QTimer>
 #include <QToolBar>
 #include <QVBoxLayout>
 
@@ -33,6 +36,7 @@
 #include "src/data/basesignal.hpp"
 #include "src/devices/basedevice.hpp"
 #include "src/devices/hardwaredevice.hpp"
+#include "src/devices/replaydevice.hpp"
 #include "src/devices/userdevice.hpp"
 #include "src/ui/devices/devicetree/devicetreemodel.hpp"
 #include "src/ui/devices/devicetree/devicetreeview.hpp"
@@ -40,6 +44,8 @@
 #include "src/ui/dialogs/connectdialog.hpp"
 #include "src/ui/views/baseview.hpp"
 
+#define HEALTH_UPDATE_INTERVAL 1000
+
 using std::shared_ptr;
 using sv::ui::devices::devicetree::DeviceTreeModel;
 using sv::ui::devices::devicetree::TreeItem;
@@ -56,6 +62,7 @@ DevicesView::DevicesView(Session &session,
 	BaseView(session, parent),
 	action_add_device_(new QAction(this)),
 	action_add_userdevice_(new QAction(this)),
+	action_add_replaydevice_(new QAction(this)),
 	action_disconnect_device_(new QAction(this))
 {
 	setup_ui();
@@ -95,6 +102,13 @@ void DevicesView::setup_toolbar()
 	connect(action_add_userdevice_, SIGNAL(triggered(bool)),
 		this, SLOT(on_action_add_userdevice_triggered()));
 
+	action_add_replaydevice_->setText(tr("Add replay device"));
+	action_add_replaydevice_->setIcon(
+		QIcon::fromTheme("media-playback-start",
+		QIcon(":/icons/media-playback-start.png")));
+	connect(action_add_replaydevice_, SIGNAL(triggered(bool)),
+		this, SLOT(on_action_add_replaydevice_triggered()));
+
 	action_disconnect_device_->setText(tr("Disconnect device"));
 	action_disconnect_device_->setIcon(
 		QIcon::fromTheme("edit-delete",
@@ -105,6 +119,7 @@ void DevicesView::setup_toolbar()
 	toolbar_ = new QToolBar("Device Tree Toolbar");
 	toolbar_->addAction(action_add_device_);
 	toolbar_->addAction(action_add_userdevice_);
+	toolbar_->addAction(action_add_replaydevice_);
 	toolbar_->addSeparator();
 	toolbar_->addAction(action_disconnect_device_);
 	this->addToolBar(Qt::TopToolBarArea, toolbar_);
@@ -112,6 +127,10 @@ void DevicesView::setup_toolbar()
 
 void DevicesView::connect_signals()
 {
+	health_timer_ = new QTimer(this);
+	connect(health_timer_, SIGNAL(timeout()),
+		this, SLOT(on_health_timer_timeout()));
+	health_timer_->start(HEALTH_UPDATE_INTERVAL);
 }
 
 void DevicesView::on_action_add_device_triggered()
@@ -134,6 +153,25 @@ void DevicesView::on_action_add_userdevice_triggered()
 	session().main_window()->add_device_tab(device);
 }
 
+void DevicesView::on_action_add_replaydevice_triggered()
+{
+	QString file_name = QFileDialog::getOpenFileName(this,
+		tr("Open recorded signals"), QString(),
+		tr("CSV files (*.csv);;All files (*)"));
+	if (file_name.isEmpty())
+		return;
+
+	try {
+		auto device = session().add_replay_device(
+			file_name.toStdString(), 1.);
+		session().main_window()->add_device_tab(device);
+	}
+	catch (const std::runtime_error &e) {
+		QMessageBox::critical(this, tr("Add replay device"),
+			QString::fromStdString(e.what()));
+	}
+}
+
 void DevicesView::on_action_disconnect_device_triggered()
 {
 	TreeItem *item = device_tree_->selected_item();
@@ -187,6 +225,11 @@ void DevicesView::on_action_disconnect_device_triggered()
 	}
 }
 
+void DevicesView::on_health_timer_timeout()
+{
+	device_tree_->update_device_health();
+}
+
 } // namespace views
 } // namespace ui
 } // namespace sv
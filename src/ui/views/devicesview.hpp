@@ -23,6 +23,7 @@
 #include <memory>
 
 #include <QAction>
+#include <QTimer>
 #include <QToolBar>
 
 #include "src/ui/views/baseview.hpp"
@@ -55,9 +56,11 @@ public:
 private:
 	QAction *const action_add_device_;
 	QAction *const action_add_userdevice_;
+	QAction *const action_add_replaydevice_;
 	QAction *const action_disconnect_device_;
 	QToolBar *toolbar_;
 	devices::devicetree::DeviceTreeView  *device_tree_;
+	QTimer *health_timer_;
 
 	void setup_ui();
 	void setup_toolbar();
@@ -66,7 +69,9 @@ private:
 private Q_SLOTS:
 	void on_action_add_device_triggered();
 	void on_action_add_userdevice_triggered();
+	void on_action_add_replaydevice_triggered();
 	void on_action_disconnect_device_triggered();
+	void on_health_timer_timeout();
 
 };
 
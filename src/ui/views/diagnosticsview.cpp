@@ -0,0 +1,156 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2020 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <memory>
+
+#include <QHeaderView>
+#include <QString>
+#include <QStringList>
+#include <QTableWidget>
+#include <QTableWidgetItem>
+#include <QTimer>
+#include <QVBoxLayout>
+
+#include "diagnosticsview.hpp"
+#include "src/session.hpp"
+#include "src/devices/basedevice.hpp"
+#include "src/ui/views/baseview.hpp"
+
+#define DIAGNOSTICS_UPDATE_INTERVAL 1000
+
+using std::shared_ptr;
+
+namespace sv {
+namespace ui {
+namespace views {
+
+DiagnosticsView::DiagnosticsView(Session &session, QWidget *parent) :
+	BaseView(session, parent)
+{
+	id_ = "diagnostics";
+
+	setup_ui();
+
+	timer_ = new QTimer(this);
+	connect(timer_, SIGNAL(timeout()), this, SLOT(update_statistics()));
+	timer_->start(DIAGNOSTICS_UPDATE_INTERVAL);
+}
+
+QString DiagnosticsView::title() const
+{
+	return tr("Diagnostics");
+}
+
+void DiagnosticsView::setup_ui()
+{
+	QVBoxLayout *layout = new QVBoxLayout();
+
+	statistics_table_ = new QTableWidget();
+	statistics_table_->setColumnCount(10);
+	statistics_table_->setHorizontalHeaderLabels(QStringList()
+		<< tr("Device")
+		<< tr("Health")
+		<< tr("Samples/s")
+		<< tr("Packets/s")
+		<< tr("Feed in [µs]")
+		<< tr("Ingest [µs]")
+		<< tr("Queue")
+		<< tr("Dropped")
+		<< tr("Last packet [s]")
+		<< tr("Config latency [ms]"));
+	statistics_table_->setEditTriggers(QAbstractItemView::NoEditTriggers);
+	statistics_table_->setSelectionMode(QAbstractItemView::NoSelection);
+	statistics_table_->verticalHeader()->setVisible(false);
+	statistics_table_->horizontalHeader()->setSectionResizeMode(
+		QHeaderView::ResizeToContents);
+	layout->addWidget(statistics_table_);
+
+	layout->setContentsMargins(2, 2, 2, 2);
+
+	this->central_widget_->setLayout(layout);
+}
+
+void DiagnosticsView::update_statistics()
+{
+	// Only update while visible, the statistics are pulled from the devices.
+	if (!this->isVisible())
+		return;
+
+	auto devices = session_.devices();
+	statistics_table_->setRowCount((int)devices.size());
+
+	int row = 0;
+	for (const auto &id_device_pair : devices) {
+		shared_ptr<devices::BaseDevice> device = id_device_pair.second;
+		devices::acquisition_statistics_t stats =
+			device->acquisition_statistics();
+
+		QString health;
+		switch (device->acquisition_health()) {
+		case devices::AcquisitionHealth::Ok:
+			health = tr("Ok");
+			break;
+		case devices::AcquisitionHealth::Lagging:
+			health = tr("Lagging");
+			break;
+		case devices::AcquisitionHealth::Idle:
+		default:
+			health = tr("Idle");
+			break;
+		}
+
+		QStringList values;
+		values << device->short_name()
+			<< health
+			<< QString::number(stats.sample_rate, 'f', 0)
+			<< QString::number(stats.packet_rate, 'f', 1)
+			<< QString("%1 / %2").
+				arg(stats.feed_in_time_avg, 0, 'f', 1).
+				arg(stats.feed_in_time_max, 0, 'f', 1)
+			<< QString("%1 / %2").
+				arg(stats.ingest_time_avg, 0, 'f', 1).
+				arg(stats.ingest_time_max, 0, 'f', 1)
+			<< QString("%1 / %2").
+				arg(stats.queue_depth).arg(stats.queue_capacity)
+			<< QString("%1 (%2/s)").
+				arg(stats.dropped_sample_count).
+				arg(stats.dropped_sample_rate, 0, 'f', 0)
+			<< (stats.time_since_last_packet < 0 ? QString("-") :
+				QString::number(stats.time_since_last_packet, 'f', 1))
+			<< (stats.config_latency_last < 0 ? QString("-") :
+				QString("%1 / %2 (%3)").
+					arg(stats.config_latency_last, 0, 'f', 1).
+					arg(stats.config_latency_max, 0, 'f', 1).
+					arg(stats.config_queue_depth));
+
+		for (int column=0; column<values.size(); ++column) {
+			QTableWidgetItem *item = statistics_table_->item(row, column);
+			if (!item) {
+				item = new QTableWidgetItem();
+				statistics_table_->setItem(row, column, item);
+			}
+			item->setText(values[column]);
+		}
+		++row;
+	}
+}
+
+} // namespace views
+} // namespace ui
+} // namespace sv
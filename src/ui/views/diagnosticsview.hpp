@@ -0,0 +1,64 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2020 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UI_VIEWS_DIAGNOSTICSVIEW_HPP
+#define UI_VIEWS_DIAGNOSTICSVIEW_HPP
+
+#include <QString>
+#include <QTableWidget>
+#include <QTimer>
+
+#include "src/ui/views/baseview.hpp"
+
+namespace sv {
+
+class Session;
+
+namespace ui {
+namespace views {
+
+/**
+ * Shows the acquisition statistics of all devices in the session, so
+ * dropped packets and a lagging data path can be spotted during a session.
+ */
+class DiagnosticsView : public BaseView
+{
+	Q_OBJECT
+
+public:
+	DiagnosticsView(Session &session, QWidget *parent = nullptr);
+
+	QString title() const override;
+
+private:
+	QTableWidget *statistics_table_;
+	QTimer *timer_;
+
+	void setup_ui();
+
+private Q_SLOTS:
+	void update_statistics();
+
+};
+
+} // namespace views
+} // namespace ui
+} // namespace sv
+
+#endif // UI_VIEWS_DIAGNOSTICSVIEW_HPP
@@ -0,0 +1,269 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2020 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cassert>
+#include <cmath>
+#include <memory>
+
+#include <QColor>
+#include <QDebug>
+#include <QVBoxLayout>
+#include <QVector>
+#include <qwt_samples.h>
+
+#include "histogramview.hpp"
+#include "src/session.hpp"
+#include "src/data/analogtimesignal.hpp"
+#include "src/data/histogram.hpp"
+
+namespace sv {
+namespace ui {
+namespace views {
+
+HistogramView::HistogramView(Session &session,
+		shared_ptr<sv::data::AnalogTimeSignal> signal,
+		QWidget *parent) :
+	BaseView(session, parent),
+	signal_(signal),
+	histogram_(100),
+	window_size_(0),
+	next_sample_pos_(0),
+	first_sample_pos_(0),
+	action_reset_display_(new QAction(this))
+{
+	assert(signal_);
+
+	id_ = "histogram:" + signal_->name();
+
+	setup_ui();
+	setup_toolbar();
+
+	timer_ = new QTimer(this);
+	connect(timer_, SIGNAL(timeout()), this, SLOT(on_update()));
+	timer_->start(250);
+}
+
+QString HistogramView::title() const
+{
+	return tr("Histogram") + " " + signal_->display_name();
+}
+
+void HistogramView::set_bin_count(size_t bin_count)
+{
+	if (bin_count == 0 || bin_count == histogram_.bin_count())
+		return;
+
+	histogram_ = sv::data::Histogram(bin_count);
+	rebuild();
+
+	bin_count_box_->blockSignals(true);
+	bin_count_box_->setValue((int)bin_count);
+	bin_count_box_->blockSignals(false);
+}
+
+void HistogramView::set_window_size(size_t window_size)
+{
+	if (window_size == window_size_)
+		return;
+
+	window_size_ = window_size;
+	rebuild();
+
+	window_size_box_->blockSignals(true);
+	window_size_box_->setValue((int)window_size);
+	window_size_box_->blockSignals(false);
+}
+
+void HistogramView::setup_ui()
+{
+	QVBoxLayout *layout = new QVBoxLayout();
+
+	plot_ = new QwtPlot();
+	plot_->setAutoReplot(false);
+	plot_->setAxisTitle(QwtPlot::xBottom, signal_->unit_name());
+	plot_->setAxisTitle(QwtPlot::yLeft, tr("Count"));
+	plot_->setMinimumSize(250, 200);
+
+	plot_histogram_ = new QwtPlotHistogram(signal_->display_name());
+	plot_histogram_->setStyle(QwtPlotHistogram::Columns);
+	plot_histogram_->setBrush(QColor(0, 87, 174));
+	plot_histogram_->setPen(QColor(0, 49, 110));
+	plot_histogram_->attach(plot_);
+	layout->addWidget(plot_, 1);
+
+	info_label_ = new QLabel();
+	layout->addWidget(info_label_);
+
+	this->central_widget_->setLayout(layout);
+}
+
+void HistogramView::setup_toolbar()
+{
+	action_reset_display_->setText(tr("Reset display"));
+	action_reset_display_->setIcon(
+		QIcon::fromTheme("view-refresh",
+		QIcon(":/icons/view-refresh.png")));
+	connect(action_reset_display_, SIGNAL(triggered(bool)),
+		this, SLOT(on_action_reset_display_triggered()));
+
+	bin_count_box_ = new QSpinBox();
+	bin_count_box_->setRange(2, 10000);
+	bin_count_box_->setValue((int)histogram_.bin_count());
+	bin_count_box_->setSuffix(tr(" bins"));
+	connect(bin_count_box_, SIGNAL(valueChanged(int)),
+		this, SLOT(on_bin_count_changed()));
+
+	window_size_box_ = new QSpinBox();
+	window_size_box_->setRange(0, 100000000);
+	window_size_box_->setValue((int)window_size_);
+	window_size_box_->setSpecialValueText(tr("All samples"));
+	window_size_box_->setSuffix(tr(" samples"));
+	window_size_box_->setToolTip(tr("Only use the last samples"));
+	connect(window_size_box_, SIGNAL(valueChanged(int)),
+		this, SLOT(on_window_size_changed()));
+
+	toolbar_ = new QToolBar("Histogram Toolbar");
+	toolbar_->addAction(action_reset_display_);
+	toolbar_->addSeparator();
+	toolbar_->addWidget(bin_count_box_);
+	toolbar_->addWidget(window_size_box_);
+	this->addToolBar(Qt::TopToolBarArea, toolbar_);
+}
+
+void HistogramView::rebuild()
+{
+	// Fit the range to the samples in the window and bin them again.
+	size_t sample_count = signal_->sample_count();
+	size_t first = 0;
+	if (window_size_ > 0 && sample_count > window_size_)
+		first = sample_count - window_size_;
+
+	bool found = false;
+	double min = 0.;
+	double max = 0.;
+	for (size_t pos = first; pos < sample_count; ++pos) {
+		double value = signal_->get_sample(pos, false).second;
+		if (!std::isfinite(value))
+			continue;
+		if (!found || value < min)
+			min = value;
+		if (!found || value > max)
+			max = value;
+		found = true;
+	}
+
+	histogram_.clear();
+	if (found)
+		histogram_.set_range(min, max);
+	for (size_t pos = first; pos < sample_count; ++pos)
+		histogram_.add(signal_->get_sample(pos, false).second);
+
+	first_sample_pos_ = first;
+	next_sample_pos_ = sample_count;
+	update_plot();
+}
+
+void HistogramView::update_plot()
+{
+	QVector<QwtIntervalSample> samples;
+	if (histogram_.has_range()) {
+		const size_t bin_count = histogram_.bin_count();
+		const double bin_width = histogram_.bin_width();
+		samples.reserve((int)bin_count);
+		for (size_t i=0; i<bin_count; ++i) {
+			double lower = histogram_.min() + (double)i * bin_width;
+			samples.append(QwtIntervalSample(
+				(double)histogram_.count(i), lower, lower + bin_width));
+		}
+	}
+	plot_histogram_->setSamples(samples);
+	plot_->replot();
+
+	info_label_->setText(tr("%1 samples, bin width %2 %3").
+		arg(histogram_.total_count()).
+		arg(histogram_.bin_width(), 0, 'g', 4).
+		arg(signal_->unit_name()));
+}
+
+void HistogramView::showEvent(QShowEvent *event)
+{
+	// Bin the samples, that were added while the view was hidden.
+	timer_->start(250);
+	on_update();
+	BaseView::showEvent(event);
+}
+
+void HistogramView::hideEvent(QHideEvent *event)
+{
+	timer_->stop();
+	BaseView::hideEvent(event);
+}
+
+void HistogramView::on_update()
+{
+	// No updates while the view is hidden (e.g. in an inactive tab),
+	// showEvent() resumes them.
+	if (!isVisible()) {
+		timer_->stop();
+		return;
+	}
+
+	size_t sample_count = signal_->sample_count();
+	if (sample_count < next_sample_pos_) {
+		// The signal has been cleared.
+		rebuild();
+		return;
+	}
+	if (sample_count == next_sample_pos_)
+		return;
+
+	for (size_t pos = next_sample_pos_; pos < sample_count; ++pos)
+		histogram_.add(signal_->get_sample(pos, false).second);
+	next_sample_pos_ = sample_count;
+
+	// Remove the samples, that have left the sliding window.
+	if (window_size_ > 0) {
+		while (sample_count - first_sample_pos_ > window_size_) {
+			histogram_.remove(
+				signal_->get_sample(first_sample_pos_, false).second);
+			++first_sample_pos_;
+		}
+	}
+
+	update_plot();
+}
+
+void HistogramView::on_bin_count_changed()
+{
+	set_bin_count((size_t)bin_count_box_->value());
+}
+
+void HistogramView::on_window_size_changed()
+{
+	set_window_size((size_t)window_size_box_->value());
+}
+
+void HistogramView::on_action_reset_display_triggered()
+{
+	rebuild();
+}
+
+} // namespace views
+} // namespace ui
+} // namespace sv
@@ -0,0 +1,115 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2020 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UI_VIEWS_HISTOGRAMVIEW_HPP
+#define UI_VIEWS_HISTOGRAMVIEW_HPP
+
+#include <memory>
+
+#include <QAction>
+#include <QLabel>
+#include <QSpinBox>
+#include <QString>
+#include <QTimer>
+#include <QToolBar>
+
+#include <qwt_plot.h>
+#include <qwt_plot_histogram.h>
+
+#include "src/data/histogram.hpp"
+#include "src/ui/views/baseview.hpp"
+
+using std::shared_ptr;
+
+namespace sv {
+
+class Session;
+
+namespace data {
+class AnalogTimeSignal;
+}
+
+namespace ui {
+namespace views {
+
+/**
+ * Shows the value distribution of a signal. New samples are binned
+ * incrementally, optionally only the last samples (sliding window) are used.
+ */
+class HistogramView : public BaseView
+{
+	Q_OBJECT
+
+public:
+	HistogramView(Session& session,
+		shared_ptr<sv::data::AnalogTimeSignal> signal,
+		QWidget* parent = nullptr);
+
+	QString title() const override;
+
+	/**
+	 * Set the number of bins. The histogram is rebuilt from the samples.
+	 */
+	void set_bin_count(size_t bin_count);
+	/**
+	 * Set the number of samples for the sliding window, 0 for all samples.
+	 * The histogram is rebuilt from the samples.
+	 */
+	void set_window_size(size_t window_size);
+
+private:
+	shared_ptr<sv::data::AnalogTimeSignal> signal_;
+	sv::data::Histogram histogram_;
+	size_t window_size_;
+	/** Position of the next signal sample, that will be binned */
+	size_t next_sample_pos_;
+	/** Position of the first sample in the histogram (sliding window) */
+	size_t first_sample_pos_;
+
+	QTimer *timer_;
+	QAction *const action_reset_display_;
+	QToolBar *toolbar_;
+	QSpinBox *bin_count_box_;
+	QSpinBox *window_size_box_;
+	QwtPlot *plot_;
+	QwtPlotHistogram *plot_histogram_;
+	QLabel *info_label_;
+
+	void setup_ui();
+	void setup_toolbar();
+	void rebuild();
+	void update_plot();
+
+protected:
+	void showEvent(QShowEvent *event) override;
+	void hideEvent(QHideEvent *event) override;
+
+private Q_SLOTS:
+	void on_update();
+	void on_bin_count_changed();
+	void on_window_size_changed();
+	void on_action_reset_display_triggered();
+
+};
+
+} // namespace views
+} // namespace ui
+} // namespace sv
+
+#endif // UI_VIEWS_HISTOGRAMVIEW_HPP
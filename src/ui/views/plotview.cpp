@@ -32,6 +32,7 @@
 #include "plotview.hpp"
 #include "src/session.hpp"
 #include "src/channels/basechannel.hpp"
+#include "src/channels/eventdetectorchannel.hpp"
 #include "src/data/analogtimesignal.hpp"
 #include "src/ui/dialogs/plotconfigdialog.hpp"
 #include "src/ui/dialogs/plotdiffmarkerdialog.hpp"
@@ -59,6 +60,8 @@ PlotView::PlotView(Session &session,
 	action_add_marker_(new QAction(this)),
 	action_add_diff_marker_(new QAction(this)),
 	action_zoom_best_fit_(new QAction(this)),
+	action_previous_event_(new QAction(this)),
+	action_next_event_(new QAction(this)),
 	action_add_signal_(new QAction(this)),
 	action_save_(new QAction(this)),
 	action_config_plot_(new QAction(this)),
@@ -100,6 +103,8 @@ PlotView::PlotView(Session &session,
 	action_add_marker_(new QAction(this)),
 	action_add_diff_marker_(new QAction(this)),
 	action_zoom_best_fit_(new QAction(this)),
+	action_previous_event_(new QAction(this)),
+	action_next_event_(new QAction(this)),
 	action_add_signal_(new QAction(this)),
 	action_save_(new QAction(this)),
 	action_config_plot_(new QAction(this)),
@@ -128,6 +133,8 @@ PlotView::PlotView(Session &session,
 	action_add_marker_(new QAction(this)),
 	action_add_diff_marker_(new QAction(this)),
 	action_zoom_best_fit_(new QAction(this)),
+	action_previous_event_(new QAction(this)),
+	action_next_event_(new QAction(this)),
 	action_add_signal_(new QAction(this)),
 	action_save_(new QAction(this)),
 	action_config_plot_(new QAction(this)),
@@ -171,6 +178,7 @@ void PlotView::add_time_curve(shared_ptr<sv::data::AnalogTimeSignal> signal)
 	if (plot_->add_curve(curve)) {
 		curves_.push_back(curve);
 		update_add_marker_menu();
+		update_event_actions();
 	}
 	else {
 		QMessageBox::warning(this,
@@ -200,6 +208,7 @@ void PlotView::add_xy_curve(shared_ptr<sv::data::AnalogTimeSignal> x_signal,
 	if (plot_->add_curve(curve)) {
 		curves_.push_back(curve);
 		update_add_marker_menu();
+		update_event_actions();
 	}
 	else {
 		QMessageBox::warning(this,
@@ -214,7 +223,6 @@ void PlotView::setup_ui()
 
 	plot_ = new widgets::plot::Plot();
 	plot_->set_update_mode(widgets::plot::PlotUpdateMode::Additive);
-	plot_->set_plot_interval(200); // 200ms
 
 	for (const auto &curve : curves_)
 		plot_->add_curve(curve);
@@ -252,6 +260,21 @@ void PlotView::setup_toolbar()
 	connect(action_zoom_best_fit_, SIGNAL(triggered(bool)),
 		this, SLOT(on_action_zoom_best_fit_triggered()));
 
+	action_previous_event_->setText(tr("Previous event"));
+	action_previous_event_->setIcon(
+		QIcon::fromTheme("go-first",
+		QIcon(":/icons/go-first.png")));
+	connect(action_previous_event_, SIGNAL(triggered(bool)),
+		this, SLOT(on_action_previous_event_triggered()));
+
+	action_next_event_->setText(tr("Next event"));
+	action_next_event_->setIcon(
+		QIcon::fromTheme("go-last",
+		QIcon(":/icons/go-last.png")));
+	connect(action_next_event_, SIGNAL(triggered(bool)),
+		this, SLOT(on_action_next_event_triggered()));
+	update_event_actions();
+
 	action_add_signal_->setText(tr("Add Signal"));
 	action_add_signal_->setIcon(
 		QIcon::fromTheme("office-chart-line",
@@ -278,6 +301,8 @@ void PlotView::setup_toolbar()
 	toolbar_->addAction(action_add_diff_marker_);
 	toolbar_->addSeparator();
 	toolbar_->addAction(action_zoom_best_fit_);
+	toolbar_->addAction(action_previous_event_);
+	toolbar_->addAction(action_next_event_);
 	toolbar_->addSeparator();
 	toolbar_->addAction(action_add_signal_);
 	toolbar_->addSeparator();
@@ -308,6 +333,68 @@ void PlotView::update_add_marker_menu()
 	}
 }
 
+void PlotView::update_event_actions()
+{
+	// The event actions are only shown, if an event channel is plotted.
+	bool has_events = false;
+	if (plot_type_ == PlotType::TimePlot) {
+		for (const auto &curve : curves_) {
+			auto signal = ((widgets::plot::TimeCurveData *)curve)->signal();
+			if (dynamic_pointer_cast<channels::EventDetectorChannel>(
+					signal->parent_channel())) {
+				has_events = true;
+				break;
+			}
+		}
+	}
+	action_previous_event_->setVisible(has_events);
+	action_next_event_->setVisible(has_events);
+}
+
+void PlotView::jump_to_event(bool next)
+{
+	if (plot_type_ != PlotType::TimePlot)
+		return;
+
+	QwtInterval x_interval = plot_->axisInterval(QwtPlot::xBottom);
+	double x_center = (x_interval.minValue() + x_interval.maxValue()) / 2;
+
+	// Search the nearest event of all event channels in the plot. The event
+	// index is searched with absolute timestamps, so the relative time of
+	// each curve must be converted.
+	bool found = false;
+	double event_x = 0.;
+	for (const auto &curve : curves_) {
+		auto signal = ((widgets::plot::TimeCurveData *)curve)->signal();
+		auto event_channel =
+			dynamic_pointer_cast<channels::EventDetectorChannel>(
+				signal->parent_channel());
+		if (!event_channel)
+			continue;
+
+		double offset = 0.;
+		if (curve->is_relative_time())
+			offset = signal->signal_start_timestamp();
+
+		int64_t pos;
+		if (next)
+			pos = event_channel->next_event(x_center + offset, false);
+		else
+			pos = event_channel->previous_event(x_center + offset, false);
+		if (pos < 0)
+			continue;
+
+		double x = event_channel->get_event(pos, false).first - offset;
+		if (!found || (next && x < event_x) || (!next && x > event_x)) {
+			event_x = x;
+			found = true;
+		}
+	}
+
+	if (found)
+		plot_->show_x_position(event_x);
+}
+
 void PlotView::connect_signals()
 {
 }
@@ -341,6 +428,7 @@ void PlotView::on_signal_changed()
 	if (plot_->add_curve(curve)) {
 		curves_.push_back(curve);
 		update_add_marker_menu();
+		update_event_actions();
 	}
 }
 
@@ -370,6 +458,16 @@ void PlotView::on_action_zoom_best_fit_triggered()
 	plot_->set_all_axis_locked(false);
 }
 
+void PlotView::on_action_previous_event_triggered()
+{
+	jump_to_event(false);
+}
+
+void PlotView::on_action_next_event_triggered()
+{
+	jump_to_event(true);
+}
+
 void PlotView::on_action_add_signal_triggered()
 {
 	shared_ptr<sv::devices::BaseDevice> selected_device;
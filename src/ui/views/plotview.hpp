@@ -96,6 +96,8 @@ private:
 	void setup_ui();
 	void setup_toolbar();
 	void update_add_marker_menu();
+	void update_event_actions();
+	void jump_to_event(bool next);
 	void connect_signals();
 	void init_values();
 
@@ -107,6 +109,8 @@ private:
 	QAction *const action_add_marker_;
 	QAction *const action_add_diff_marker_;
 	QAction *const action_zoom_best_fit_;
+	QAction *const action_previous_event_;
+	QAction *const action_next_event_;
 	QAction *const action_add_signal_;
 	QAction *const action_save_;
 	QAction *const action_config_plot_;
@@ -119,6 +123,8 @@ private Q_SLOTS:
 	void on_action_add_marker_triggered();
 	void on_action_add_diff_marker_triggered();
 	void on_action_zoom_best_fit_triggered();
+	void on_action_previous_event_triggered();
+	void on_action_next_event_triggered();
 	void on_action_add_signal_triggered();
 	void on_action_save_triggered();
 	void on_action_config_plot_triggered();
@@ -17,21 +17,24 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
 #include <set>
 #include <string>
+#include <vector>
 
 #include <QApplication>
-#include <QDateTime>
 #include <QVBoxLayout>
 
 #include "powerpanelview.hpp"
 #include "src/session.hpp"
+#include "src/sessionclock.hpp"
 #include "src/util.hpp"
 #include "src/data/analogtimesignal.hpp"
 #include "src/data/datautil.hpp"
 #include "src/ui/widgets/monofontdisplay.hpp"
 
 using std::set;
+using std::vector;
 using sv::data::QuantityFlag;
 
 namespace sv {
@@ -55,6 +58,7 @@ PowerPanelView::PowerPanelView(Session &session,
 	power_max_(std::numeric_limits<double>::lowest()),
 	actual_amp_hours_(0),
 	actual_watt_hours_(0),
+	is_paused_(false),
 	action_reset_displays_(new QAction(this))
 {
 	id_ = "powerpanel:" + voltage_signal_->name() +
@@ -282,7 +286,7 @@ void PowerPanelView::init_timer()
 	if (!voltage_signal_ && !current_signal_)
 		return;
 
-	start_time_ = QDateTime::currentMSecsSinceEpoch();
+	start_time_ = SessionClock::now();
 	last_time_ = start_time_;
 
 	voltage_min_ = std::numeric_limits<double>::max();
@@ -302,22 +306,111 @@ void PowerPanelView::init_timer()
 
 void PowerPanelView::stop_timer()
 {
-	if (!timer_->isActive())
+	if (!timer_->isActive() && !is_paused_)
 		return;
 
+	is_paused_ = false;
 	timer_->stop();
 	disconnect(timer_, SIGNAL(timeout()), this, SLOT(on_update()));
 
 	reset_displays();
 }
 
+void PowerPanelView::pause_updates()
+{
+	if (!timer_->isActive())
+		return;
+
+	timer_->stop();
+	is_paused_ = true;
+}
+
+void PowerPanelView::resume_updates()
+{
+	if (!is_paused_)
+		return;
+	is_paused_ = false;
+
+	catch_up();
+	on_update();
+	timer_->start(250);
+}
+
+void PowerPanelView::catch_up()
+{
+	if (!voltage_signal_ || !current_signal_)
+		return;
+
+	// Integrate the current samples, that were added while the view was
+	// hidden, and catch up with the min/max values.
+	const vector<double> &time_data = current_signal_->time_data();
+	const vector<double> &value_data = current_signal_->value_data();
+	double last_timestamp = last_time_;
+	auto it = std::upper_bound(
+		time_data.begin(), time_data.end(), last_timestamp);
+	for (size_t pos = it - time_data.begin(); pos < time_data.size(); ++pos) {
+		double timestamp = time_data[pos];
+		double current = value_data[pos];
+		double voltage;
+		if (!voltage_signal_->get_value_at_timestamp(timestamp, voltage, false))
+			continue;
+		double elapsed_time = (timestamp - last_timestamp) / 3600.; // / 1h
+		last_timestamp = timestamp;
+
+		if (voltage_min_ > voltage)
+			voltage_min_ = voltage;
+		if (voltage_max_ < voltage)
+			voltage_max_ = voltage;
+		if (current_min_ > current)
+			current_min_ = current;
+		if (current_max_ < current)
+			current_max_ = current;
+
+		double resistance = current == 0. ?
+			std::numeric_limits<double>::max() : voltage / current;
+		if (resistance_min_ > resistance)
+			resistance_min_ = resistance;
+		if (resistance_max_ < resistance)
+			resistance_max_ = resistance;
+
+		double power = voltage * current;
+		if (power_min_ > power)
+			power_min_ = power;
+		if (power_max_ < power)
+			power_max_ = power;
+
+		actual_amp_hours_ = actual_amp_hours_ + (current * elapsed_time);
+		actual_watt_hours_ = actual_watt_hours_ + (power * elapsed_time);
+	}
+	last_time_ = last_timestamp;
+}
+
+void PowerPanelView::showEvent(QShowEvent *event)
+{
+	resume_updates();
+	BaseView::showEvent(event);
+}
+
+void PowerPanelView::hideEvent(QHideEvent *event)
+{
+	pause_updates();
+	BaseView::hideEvent(event);
+}
+
 void PowerPanelView::on_update()
 {
+	// No updates while the view is hidden (e.g. in an inactive tab),
+	// showEvent() resumes them.
+	if (!isVisible()) {
+		pause_updates();
+		return;
+	}
+
 	if (voltage_signal_->sample_count() == 0)
 		return;
 
-	qint64 now = QDateTime::currentMSecsSinceEpoch();
-	double elapsed_time = (double)(now - last_time_) / (double)3600000; // / 1h
+	double now = SessionClock::now();
+	double elapsed_time = (now - last_time_) / 3600.; // / 1h
 	last_time_ = now;
 
 	double voltage = 0.;
@@ -64,8 +64,9 @@ private:
 	shared_ptr<sv::data::AnalogTimeSignal> current_signal_;
 
 	QTimer *timer_;
-	qint64 start_time_;
-	qint64 last_time_;
+	/** Timestamps of the SessionClock in s, like the signal timestamps */
+	double start_time_;
+	double last_time_;
 
 	// Min/max/actual values are stored here, so they can be reseted
 	double voltage_min_;
@@ -78,6 +79,8 @@ private:
 	double power_max_;
 	double actual_amp_hours_;
 	double actual_watt_hours_;
+	/** Timer is paused while the view is hidden */
+	bool is_paused_;
 
 	QAction *const action_reset_displays_;
 	QToolBar *toolbar_;
@@ -102,6 +105,13 @@ private:
 	void reset_displays();
 	void init_timer();
 	void stop_timer();
+	void pause_updates();
+	void resume_updates();
+	void catch_up();
+
+protected:
+	void showEvent(QShowEvent *event) override;
+	void hideEvent(QHideEvent *event) override;
 
 private Q_SLOTS:
 	void on_update();
@@ -0,0 +1,154 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2020 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cassert>
+#include <memory>
+
+#include <QDebug>
+#include <QVBoxLayout>
+
+#include "spectrogramview.hpp"
+#include "src/session.hpp"
+#include "src/channels/fftchannel.hpp"
+#include "src/data/analogsamplesignal.hpp"
+#include "src/ui/widgets/spectrogramwidget.hpp"
+
+namespace sv {
+namespace ui {
+namespace views {
+
+SpectrogramView::SpectrogramView(Session &session,
+		shared_ptr<channels::FftChannel> channel,
+		QWidget *parent) :
+	BaseView(session, parent),
+	channel_(channel),
+	frequency_resolution_(0.),
+	action_reset_display_(new QAction(this))
+{
+	assert(channel_);
+
+	id_ = "spectrogram:" + channel_->name();
+	amplitudes_.reserve(channel_->bin_count());
+
+	setup_ui();
+	setup_toolbar();
+
+	connect(channel_.get(), SIGNAL(spectrum_updated()),
+		this, SLOT(on_spectrum_updated()));
+}
+
+QString SpectrogramView::title() const
+{
+	return tr("Spectrogram") + " " + channel_->display_name();
+}
+
+void SpectrogramView::setup_ui()
+{
+	QVBoxLayout *layout = new QVBoxLayout();
+
+	spectrogram_widget_ = new widgets::SpectrogramWidget(512);
+	layout->addWidget(spectrogram_widget_, 1);
+
+	frequency_label_ = new QLabel();
+	layout->addWidget(frequency_label_);
+	update_frequency_label();
+
+	this->central_widget_->setLayout(layout);
+}
+
+void SpectrogramView::setup_toolbar()
+{
+	action_reset_display_->setText(tr("Reset display"));
+	action_reset_display_->setIcon(
+		QIcon::fromTheme("view-refresh",
+		QIcon(":/icons/view-refresh.png")));
+	connect(action_reset_display_, SIGNAL(triggered(bool)),
+		this, SLOT(on_action_reset_display_triggered()));
+
+	lower_level_box_ = new QDoubleSpinBox();
+	lower_level_box_->setRange(-300., 300.);
+	lower_level_box_->setDecimals(0);
+	lower_level_box_->setSingleStep(10.);
+	lower_level_box_->setSuffix(" dB");
+	lower_level_box_->setValue(spectrogram_widget_->lower_level());
+	lower_level_box_->setToolTip(tr("Level of the lowest color"));
+	connect(lower_level_box_, SIGNAL(valueChanged(double)),
+		this, SLOT(on_level_changed()));
+
+	upper_level_box_ = new QDoubleSpinBox();
+	upper_level_box_->setRange(-300., 300.);
+	upper_level_box_->setDecimals(0);
+	upper_level_box_->setSingleStep(10.);
+	upper_level_box_->setSuffix(" dB");
+	upper_level_box_->setValue(spectrogram_widget_->upper_level());
+	upper_level_box_->setToolTip(tr("Level of the highest color"));
+	connect(upper_level_box_, SIGNAL(valueChanged(double)),
+		this, SLOT(on_level_changed()));
+
+	toolbar_ = new QToolBar("Spectrogram Toolbar");
+	toolbar_->addAction(action_reset_display_);
+	toolbar_->addSeparator();
+	toolbar_->addWidget(new QLabel(tr("Levels")));
+	toolbar_->addWidget(lower_level_box_);
+	toolbar_->addWidget(upper_level_box_);
+	this->addToolBar(Qt::TopToolBarArea, toolbar_);
+}
+
+void SpectrogramView::update_frequency_label()
+{
+	frequency_resolution_ = channel_->frequency_resolution();
+	if (frequency_resolution_ <= 0) {
+		frequency_label_->setText(tr("Waiting for the first spectrum..."));
+		return;
+	}
+
+	double max_frequency =
+		frequency_resolution_ * (double)(channel_->bin_count() - 1);
+	frequency_label_->setText(tr("0 Hz - %1 Hz (%2 Hz/bin)").
+		arg(max_frequency, 0, 'g', 6).arg(frequency_resolution_, 0, 'g', 4));
+}
+
+void SpectrogramView::on_spectrum_updated()
+{
+	auto spectrum_signal = channel_->spectrum_signal();
+	size_t bin_count = spectrum_signal->sample_count();
+	amplitudes_.resize(bin_count);
+	for (size_t i=0; i<bin_count; ++i)
+		amplitudes_[i] = spectrum_signal->get_sample((uint32_t)i).second;
+
+	spectrogram_widget_->add_spectrum(amplitudes_);
+
+	if (channel_->frequency_resolution() != frequency_resolution_)
+		update_frequency_label();
+}
+
+void SpectrogramView::on_level_changed()
+{
+	spectrogram_widget_->set_level_range(
+		lower_level_box_->value(), upper_level_box_->value());
+}
+
+void SpectrogramView::on_action_reset_display_triggered()
+{
+	spectrogram_widget_->clear();
+}
+
+} // namespace views
+} // namespace ui
+} // namespace sv
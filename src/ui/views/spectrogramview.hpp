@@ -0,0 +1,95 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2020 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UI_VIEWS_SPECTROGRAMVIEW_HPP
+#define UI_VIEWS_SPECTROGRAMVIEW_HPP
+
+#include <memory>
+#include <vector>
+
+#include <QAction>
+#include <QDoubleSpinBox>
+#include <QLabel>
+#include <QString>
+#include <QToolBar>
+
+#include "src/ui/views/baseview.hpp"
+
+using std::shared_ptr;
+using std::vector;
+
+namespace sv {
+
+class Session;
+
+namespace channels {
+class FftChannel;
+}
+
+namespace ui {
+
+namespace widgets {
+class SpectrogramWidget;
+}
+
+namespace views {
+
+/**
+ * Waterfall view of the spectra of a FFT channel. Every spectrum frame of
+ * the channel adds one row to the waterfall.
+ */
+class SpectrogramView : public BaseView
+{
+	Q_OBJECT
+
+public:
+	SpectrogramView(Session& session,
+		shared_ptr<channels::FftChannel> channel,
+		QWidget* parent = nullptr);
+
+	QString title() const override;
+
+private:
+	shared_ptr<channels::FftChannel> channel_;
+	vector<double> amplitudes_;
+	double frequency_resolution_;
+
+	QAction *const action_reset_display_;
+	QToolBar *toolbar_;
+	QDoubleSpinBox *lower_level_box_;
+	QDoubleSpinBox *upper_level_box_;
+	widgets::SpectrogramWidget *spectrogram_widget_;
+	QLabel *frequency_label_;
+
+	void setup_ui();
+	void setup_toolbar();
+	void update_frequency_label();
+
+private Q_SLOTS:
+	void on_spectrum_updated();
+	void on_level_changed();
+	void on_action_reset_display_triggered();
+
+};
+
+} // namespace views
+} // namespace ui
+} // namespace sv
+
+#endif // UI_VIEWS_SPECTROGRAMVIEW_HPP
@@ -49,6 +49,8 @@ ValuePanelView::ValuePanelView(Session &session,
 	unit_suffix_(""),
 	value_min_(std::numeric_limits<double>::max()),
 	value_max_(std::numeric_limits<double>::lowest()),
+	is_paused_(false),
+	paused_sample_pos_(0),
 	action_reset_display_(new QAction(this))
 {
 	assert(channel_);
@@ -93,6 +95,8 @@ ValuePanelView::ValuePanelView(Session& session,
 	unit_suffix_(""),
 	value_min_(std::numeric_limits<double>::max()),
 	value_max_(std::numeric_limits<double>::lowest()),
+	is_paused_(false),
+	paused_sample_pos_(0),
 	action_reset_display_(new QAction(this))
 {
 	assert(signal_);
@@ -244,17 +248,73 @@ void ValuePanelView::init_timer()
 
 void ValuePanelView::stop_timer()
 {
-	if (!timer_->isActive())
+	if (!timer_->isActive() && !is_paused_)
 		return;
 
+	is_paused_ = false;
 	timer_->stop();
 	disconnect(timer_, SIGNAL(timeout()), this, SLOT(on_update()));
 
 	reset_display();
 }
 
+void ValuePanelView::pause_updates()
+{
+	if (!timer_->isActive())
+		return;
+
+	timer_->stop();
+	is_paused_ = true;
+	paused_sample_pos_ = signal_ ? signal_->sample_count() : 0;
+}
+
+void ValuePanelView::resume_updates()
+{
+	if (!is_paused_)
+		return;
+	is_paused_ = false;
+
+	// Catch up with the min/max of the samples, that were added while the
+	// view was hidden.
+	if (signal_) {
+		size_t sample_count = signal_->sample_count();
+		size_t pos = paused_sample_pos_;
+		if (pos > sample_count)
+			pos = 0;
+		for (; pos < sample_count; ++pos) {
+			double value = signal_->get_sample(pos, false).second;
+			if (value_min_ > value)
+				value_min_ = value;
+			if (value_max_ < value)
+				value_max_ = value;
+		}
+	}
+
+	on_update();
+	timer_->start(250);
+}
+
+void ValuePanelView::showEvent(QShowEvent *event)
+{
+	resume_updates();
+	BaseView::showEvent(event);
+}
+
+void ValuePanelView::hideEvent(QHideEvent *event)
+{
+	pause_updates();
+	BaseView::hideEvent(event);
+}
+
 void ValuePanelView::on_update()
 {
+	// No updates while the view is hidden (e.g. in an inactive tab),
+	// showEvent() resumes them.
+	if (!isVisible()) {
+		pause_updates();
+		return;
+	}
+
 	if (!signal_ || signal_->sample_count() == 0)
 		return;
 
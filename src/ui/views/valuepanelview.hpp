@@ -86,6 +86,10 @@ private:
 	// Min/max/actual values are stored here, so they can be reseted
 	double value_min_;
 	double value_max_;
+	/** Timer is paused while the view is hidden */
+	bool is_paused_;
+	/** Sample count of the signal, when the timer was paused */
+	size_t paused_sample_pos_;
 
 	QAction *const action_reset_display_;
 	QToolBar *toolbar_;
@@ -101,6 +105,12 @@ private:
 	void reset_display();
 	void init_timer();
 	void stop_timer();
+	void pause_updates();
+	void resume_updates();
+
+protected:
+	void showEvent(QShowEvent *event) override;
+	void hideEvent(QHideEvent *event) override;
 
 private Q_SLOTS:
 	void on_update();
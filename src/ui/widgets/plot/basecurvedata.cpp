@@ -110,6 +110,11 @@ bool BaseCurveData::is_relative_time() const
 	return relative_time_;
 }
 
+size_t BaseCurveData::first_index() const
+{
+	return 0;
+}
+
 } // namespace plot
 } // namespace widgets
 } // namespace ui
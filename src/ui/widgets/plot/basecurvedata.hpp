@@ -26,6 +26,7 @@
 #include <QPointF>
 #include <QRectF>
 #include <QString>
+#include <qwt_scale_map.h>
 #include <qwt_series_data.h>
 
 #include "src/data/datautil.hpp"
@@ -59,8 +60,19 @@ public:
 	virtual QPointF sample(size_t i) const = 0;
 	virtual size_t size() const = 0;
 	virtual QRectF boundingRect() const = 0;
-
-	virtual QPointF closest_point(const QPointF &pos, double *dist) const = 0;
+	/**
+	 * Return the position of sample(0) in the underlying data, when the
+	 * series is limited to a range of the data.
+	 */
+	virtual size_t first_index() const;
+
+	/**
+	 * Return the sample that is closest to pos. The scale maps of the axes
+	 * are used to calculate the distance in screen space (pixels).
+	 */
+	virtual QPointF closest_point(const QPointF &pos,
+		const QwtScaleMap &x_map, const QwtScaleMap &y_map,
+		double *dist) const = 0;
 	virtual QString name() const = 0;
 	virtual sv::data::Quantity x_quantity() const = 0;
 	virtual set<sv::data::QuantityFlag> x_quantity_flags() const = 0;
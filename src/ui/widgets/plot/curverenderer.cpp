@@ -0,0 +1,181 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2020 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <cassert>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <QImage>
+#include <QPainter>
+#include <QRectF>
+#include <QSize>
+#include <qwt_plot_curve.h>
+#include <qwt_plot_item.h>
+#include <qwt_scale_map.h>
+#include <qwt_symbol.h>
+
+#include "curverenderer.hpp"
+
+using std::lock_guard;
+using std::map;
+using std::mutex;
+using std::unique_lock;
+using std::vector;
+
+namespace sv {
+namespace ui {
+namespace widgets {
+namespace plot {
+
+CurveRenderer::CurveRenderer(QObject *parent) :
+	QObject(parent),
+	frame_pending_(false),
+	stop_(false)
+{
+	render_thread_ = std::thread(&CurveRenderer::render_thread_proc, this);
+}
+
+CurveRenderer::~CurveRenderer()
+{
+	{
+		lock_guard<mutex> lock(render_mutex_);
+		stop_ = true;
+	}
+	render_cv_.notify_one();
+	if (render_thread_.joinable())
+		render_thread_.join();
+}
+
+void CurveRenderer::render(const QSize &size, const QRectF &canvas_rect,
+	vector<curve_snapshot_t> curves)
+{
+	{
+		lock_guard<mutex> lock(render_mutex_);
+		assert(!frame_pending_);
+		pending_size_ = size;
+		pending_canvas_rect_ = canvas_rect;
+		pending_curves_ = std::move(curves);
+		frame_pending_ = true;
+	}
+	render_cv_.notify_one();
+}
+
+void CurveRenderer::render_thread_proc()
+{
+	while (true) {
+		QSize size;
+		QRectF canvas_rect;
+		vector<curve_snapshot_t> curves;
+		{
+			unique_lock<mutex> lock(render_mutex_);
+			render_cv_.wait(lock, [this] { return frame_pending_ || stop_; });
+			if (stop_)
+				return;
+			size = pending_size_;
+			canvas_rect = pending_canvas_rect_;
+			curves.swap(pending_curves_);
+			frame_pending_ = false;
+		}
+
+		apply_snapshots(curves);
+		QImage frame = rasterize(size, canvas_rect, curves);
+		Q_EMIT frame_rendered(frame);
+	}
+}
+
+void CurveRenderer::apply_snapshots(const vector<curve_snapshot_t> &curves)
+{
+	map<const void *, QVector<QPointF>> curve_points;
+	for (const auto &snapshot : curves) {
+		QVector<QPointF> &points = curve_points[snapshot.curve_key];
+		if (!snapshot.reset) {
+			points.swap(curve_points_[snapshot.curve_key]);
+			points.remove(0, std::min(snapshot.removed_count, points.size()));
+		}
+		points += snapshot.points;
+	}
+	curve_points_.swap(curve_points);
+}
+
+QImage CurveRenderer::rasterize(const QSize &size, const QRectF &canvas_rect,
+	const vector<curve_snapshot_t> &curves) const
+{
+	QImage image(size, QImage::Format_ARGB32_Premultiplied);
+	image.fill(Qt::transparent);
+	if (image.isNull())
+		return image;
+
+	QPainter painter(&image);
+	for (const auto &snapshot : curves) {
+		// The curve (and the symbol) is only used locally in this thread, the
+		// data is the copy of the points in the render thread.
+		QwtPlotCurve curve;
+		curve.setSamples(curve_points_.at(snapshot.curve_key));
+		curve.setPen(snapshot.pen);
+		curve.setBrush(snapshot.brush);
+		curve.setStyle(snapshot.style);
+		curve.setRenderHint(QwtPlotItem::RenderAntialiased, snapshot.antialiased);
+		curve.setPaintAttribute(QwtPlotCurve::ClipPolygons, true);
+		if (snapshot.has_symbol) {
+			curve.setSymbol(new QwtSymbol(snapshot.symbol_style,
+				snapshot.symbol_brush, snapshot.symbol_pen,
+				snapshot.symbol_size));
+		}
+		curve.draw(&painter, snapshot.x_map, snapshot.y_map, canvas_rect);
+	}
+	painter.end();
+
+	return image;
+}
+
+CurveImageItem::CurveImageItem() : QwtPlotItem()
+{
+	setItemAttribute(QwtPlotItem::Legend, false);
+	setItemAttribute(QwtPlotItem::AutoScale, false);
+}
+
+int CurveImageItem::rtti() const
+{
+	return QwtPlotItem::Rtti_PlotUserItem;
+}
+
+void CurveImageItem::draw(QPainter *painter, const QwtScaleMap &x_map,
+	const QwtScaleMap &y_map, const QRectF &canvas_rect) const
+{
+	(void)x_map;
+	(void)y_map;
+	(void)canvas_rect;
+
+	if (!image_.isNull())
+		painter->drawImage(QPointF(0, 0), image_);
+}
+
+void CurveImageItem::set_image(const QImage &image)
+{
+	image_ = image;
+}
+
+} // namespace plot
+} // namespace widgets
+} // namespace ui
+} // namespace sv
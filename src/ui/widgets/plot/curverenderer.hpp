@@ -0,0 +1,152 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2020 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UI_WIDGETS_PLOT_CURVERENDERER_HPP
+#define UI_WIDGETS_PLOT_CURVERENDERER_HPP
+
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <QBrush>
+#include <QImage>
+#include <QObject>
+#include <QPen>
+#include <QPointF>
+#include <QRectF>
+#include <QSize>
+#include <QVector>
+#include <qwt_plot_curve.h>
+#include <qwt_plot_item.h>
+#include <qwt_scale_map.h>
+#include <qwt_symbol.h>
+
+using std::condition_variable;
+using std::map;
+using std::mutex;
+using std::vector;
+
+namespace sv {
+namespace ui {
+namespace widgets {
+namespace plot {
+
+/**
+ * A copy of everything that is needed to draw a curve, taken in the GUI
+ * thread, so the render thread doesn't touch any live data.
+ *
+ * The render thread keeps the points of a curve between the frames, so the
+ * snapshot only contains the changes since the last frame.
+ */
+struct curve_snapshot_t {
+	/** Identifies the curve between the frames. */
+	const void *curve_key;
+	/** Discard the points of the last frame. */
+	bool reset;
+	/** Number of points, that are removed from the front of the curve. */
+	int removed_count;
+	/** Points, that are appended to the curve. */
+	QVector<QPointF> points;
+	QwtScaleMap x_map;
+	QwtScaleMap y_map;
+	QPen pen;
+	QBrush brush;
+	QwtPlotCurve::CurveStyle style;
+	bool antialiased;
+	bool has_symbol;
+	QwtSymbol::Style symbol_style;
+	QBrush symbol_brush;
+	QPen symbol_pen;
+	QSize symbol_size;
+};
+
+/**
+ * Renders curves into a QImage in a worker thread (CPU only, with the Qt
+ * raster engine).
+ *
+ * Only one frame is rendered at a time. Because the snapshots only contain
+ * the changes since the last frame, a new frame must not be queued, before
+ * the last frame has been handed to the GUI thread via the frame_rendered()
+ * signal. Curves, that are missing in a frame, are discarded.
+ */
+class CurveRenderer : public QObject
+{
+	Q_OBJECT
+
+public:
+	CurveRenderer(QObject *parent = nullptr);
+	~CurveRenderer();
+
+	/**
+	 * Queue a new frame with the given canvas size and curve snapshots.
+	 * Must not be called again before frame_rendered() has been emitted.
+	 */
+	void render(const QSize &size, const QRectF &canvas_rect,
+		vector<curve_snapshot_t> curves);
+
+private:
+	void render_thread_proc();
+	void apply_snapshots(const vector<curve_snapshot_t> &curves);
+	QImage rasterize(const QSize &size, const QRectF &canvas_rect,
+		const vector<curve_snapshot_t> &curves) const;
+
+	std::thread render_thread_;
+	mutex render_mutex_;
+	condition_variable render_cv_;
+	bool frame_pending_;
+	bool stop_;
+	QSize pending_size_;
+	QRectF pending_canvas_rect_;
+	vector<curve_snapshot_t> pending_curves_;
+	/** The points of the curves, only used by the render thread. */
+	map<const void *, QVector<QPointF>> curve_points_;
+
+Q_SIGNALS:
+	void frame_rendered(QImage frame);
+
+};
+
+/**
+ * Plot item, that blits the last frame of a CurveRenderer onto the canvas.
+ */
+class CurveImageItem : public QwtPlotItem
+{
+
+public:
+	CurveImageItem();
+
+	int rtti() const override;
+	void draw(QPainter *painter, const QwtScaleMap &x_map,
+		const QwtScaleMap &y_map, const QRectF &canvas_rect) const override;
+
+	void set_image(const QImage &image);
+
+private:
+	QImage image_;
+
+};
+
+} // namespace plot
+} // namespace widgets
+} // namespace ui
+} // namespace sv
+
+#endif // UI_WIDGETS_PLOT_CURVERENDERER_HPP
@@ -0,0 +1,137 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2020 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+#include "minmaxindex.hpp"
+
+using std::vector;
+
+namespace sv {
+namespace ui {
+namespace widgets {
+namespace plot {
+
+MinMaxIndex::MinMaxIndex(const vector<double> &data) :
+	data_(data),
+	count_(0)
+{
+}
+
+void MinMaxIndex::update(size_t count)
+{
+	if (count < count_)
+		clear();
+	count_ = count;
+
+	// Summarize the complete blocks of values. A block without any finite
+	// value gets an empty (inverted) range.
+	while ((block_min_.size() + 1) * block_size_ <= count_) {
+		size_t first = block_min_.size() * block_size_;
+		double min = std::numeric_limits<double>::infinity();
+		double max = -std::numeric_limits<double>::infinity();
+		scan(data_, data_, first, first + block_size_, min, max);
+		block_min_.push_back(min);
+		block_max_.push_back(max);
+	}
+
+	// Summarize the complete blocks of blocks
+	while ((super_block_min_.size() + 1) * block_size_ <= block_min_.size()) {
+		size_t first = super_block_min_.size() * block_size_;
+		super_block_min_.push_back(*std::min_element(
+			block_min_.begin() + first, block_min_.begin() + first + block_size_));
+		super_block_max_.push_back(*std::max_element(
+			block_max_.begin() + first, block_max_.begin() + first + block_size_));
+	}
+}
+
+void MinMaxIndex::clear()
+{
+	count_ = 0;
+	block_min_.clear();
+	block_max_.clear();
+	super_block_min_.clear();
+	super_block_max_.clear();
+}
+
+bool MinMaxIndex::min_max(size_t first, size_t end,
+	double &min, double &max) const
+{
+	end = std::min(end, count_);
+	if (first >= end)
+		return false;
+
+	min = std::numeric_limits<double>::infinity();
+	max = -std::numeric_limits<double>::infinity();
+
+	// Values up to the first complete block
+	size_t block_first = (first + block_size_ - 1) / block_size_;
+	size_t block_end = std::min(end / block_size_, block_min_.size());
+	if (block_first >= block_end) {
+		// The range doesn't contain a complete block
+		scan(data_, data_, first, end, min, max);
+		return min <= max;
+	}
+	scan(data_, data_, first, block_first * block_size_, min, max);
+
+	// Blocks up to the first complete super block
+	size_t super_first = (block_first + block_size_ - 1) / block_size_;
+	size_t super_end =
+		std::min(block_end / block_size_, super_block_min_.size());
+	if (super_first >= super_end) {
+		scan(block_min_, block_max_, block_first, block_end, min, max);
+	}
+	else {
+		scan(block_min_, block_max_,
+			block_first, super_first * block_size_, min, max);
+		scan(super_block_min_, super_block_max_,
+			super_first, super_end, min, max);
+		scan(block_min_, block_max_,
+			super_end * block_size_, block_end, min, max);
+	}
+
+	// Values after the last complete block
+	scan(data_, data_, block_end * block_size_, end, min, max);
+
+	// No finite value in the range
+	return min <= max;
+}
+
+void MinMaxIndex::scan(const vector<double> &min_data,
+	const vector<double> &max_data, size_t first, size_t end,
+	double &min, double &max) const
+{
+	// Skip non-finite values (e.g. +inf for an overload), they would break
+	// the axis scale.
+	for (size_t i=first; i<end; ++i) {
+		if (std::isfinite(min_data[i]) && min_data[i] < min)
+			min = min_data[i];
+		if (std::isfinite(max_data[i]) && max_data[i] > max)
+			max = max_data[i];
+	}
+}
+
+} // namespace plot
+} // namespace widgets
+} // namespace ui
+} // namespace sv
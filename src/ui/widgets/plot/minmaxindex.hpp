@@ -0,0 +1,87 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2020 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UI_WIDGETS_PLOT_MINMAXINDEX_HPP
+#define UI_WIDGETS_PLOT_MINMAXINDEX_HPP
+
+#include <cstddef>
+#include <vector>
+
+using std::vector;
+
+namespace sv {
+namespace ui {
+namespace widgets {
+namespace plot {
+
+/**
+ * Min/max summary of a growing vector of values, for fast min/max queries
+ * of arbitrary position ranges.
+ *
+ * The values are summarized in blocks of block_size_ values and the blocks
+ * again in super blocks of block_size_ blocks. Only complete blocks are
+ * summarized, so appending is O(1) amortized and a query only has to scan
+ * the (partial) blocks at the borders of the range.
+ */
+class MinMaxIndex
+{
+
+public:
+	MinMaxIndex(const vector<double> &data);
+
+	/**
+	 * Summarize the values up to count. If count is smaller than the number
+	 * of already summarized values (the data was cleared), the index is
+	 * rebuilt.
+	 */
+	void update(size_t count);
+
+	/**
+	 * Remove all summaries.
+	 */
+	void clear();
+
+	/**
+	 * Get the minimum and maximum value of the positions [first, end).
+	 * Non-finite values (inf, nan) are skipped. Return false if the range
+	 * contains no finite value.
+	 */
+	bool min_max(size_t first, size_t end, double &min, double &max) const;
+
+private:
+	void scan(const vector<double> &min_data, const vector<double> &max_data,
+		size_t first, size_t end, double &min, double &max) const;
+
+	const vector<double> &data_;
+	size_t count_;
+	vector<double> block_min_;
+	vector<double> block_max_;
+	vector<double> super_block_min_;
+	vector<double> super_block_max_;
+
+	static const size_t block_size_ = 256;
+
+};
+
+} // namespace plot
+} // namespace widgets
+} // namespace ui
+} // namespace sv
+
+#endif // UI_WIDGETS_PLOT_MINMAXINDEX_HPP
@@ -20,17 +20,22 @@
 
 #include <cassert>
 #include <cmath>
+#include <vector>
+#include <set>
 #include <utility>
 
 #include <QBoxLayout>
 #include <QDebug>
 #include <QEvent>
 #include <QHBoxLayout>
+#include <QPainter>
 #include <QPen>
 #include <QPoint>
 #include <QPointF>
 #include <QPushButton>
+#include <QRect>
 #include <QRectF>
+#include <QRegion>
 #include <QSize>
 #include <QVBoxLayout>
 #include <qwt_scale_widget.h>
@@ -43,6 +48,7 @@
 #include <qwt_plot_curve.h>
 #include <qwt_plot_directpainter.h>
 #include <qwt_plot_grid.h>
+#include <qwt_plot_item.h>
 #include <qwt_plot_layout.h>
 #include <qwt_plot_textlabel.h>
 #include <qwt_plot_panner.h>
@@ -55,10 +61,15 @@
 #include "src/ui/dialogs/plotcurveconfigdialog.hpp"
 #include "src/ui/widgets/plot/axislocklabel.hpp"
 #include "src/ui/widgets/plot/basecurvedata.hpp"
+#include "src/ui/widgets/plot/curverenderer.hpp"
 #include "src/ui/widgets/plot/plotmagnifier.hpp"
+#include "src/ui/widgets/plot/plotscheduler.hpp"
 #include "src/ui/widgets/plot/plotscalepicker.hpp"
+#include "src/ui/widgets/plot/timecurvedata.hpp"
 
 using std::make_pair;
+using std::set;
+using std::vector;
 
 namespace sv {
 namespace ui {
@@ -124,15 +135,20 @@ private:
 };
 
 Plot::Plot(QWidget *parent) : QwtPlot(parent),
-	plot_interval_(200),
-	timer_id_(-1),
 	time_span_(120.),
 	add_time_(30.),
 	active_marker_(nullptr),
 	markers_label_(nullptr),
 	markers_label_alignment_(Qt::AlignBottom | Qt::AlignHCenter),
 	marker_select_picker_(nullptr),
-	marker_move_picker_(nullptr)
+	marker_move_picker_(nullptr),
+	background_rendering_(false),
+	curve_renderer_(nullptr),
+	curve_image_item_(nullptr),
+	frame_rendering_(false),
+	frame_requested_(false),
+	is_running_(false),
+	visible_y_autoscale_(false)
 {
 	this->setAutoReplot(false);
 	this->setCanvas(new Canvas());
@@ -183,6 +199,8 @@ Plot::~Plot()
 {
 	//qWarning() << "Plot::~Plot() for " << curve_data_->name();
 	this->stop();
+	// Stop the render thread before the curves are deleted.
+	delete curve_renderer_;
 	for (auto &direct_painter_pair : plot_direct_painter_map_) {
 		delete direct_painter_pair.second;
 	}
@@ -190,24 +208,51 @@ Plot::~Plot()
 
 void Plot::start()
 {
-	timer_id_ = startTimer(plot_interval_);
+	is_running_ = true;
+	// A hidden plot is added to the scheduler when it is shown.
+	if (isVisible())
+		PlotScheduler::instance()->add_plot(this);
 }
 
 void Plot::stop()
 {
 	//qWarning() << "Plot::stop() for " << curve_data_->name();
-	killTimer(timer_id_);
+	is_running_ = false;
+	PlotScheduler::instance()->remove_plot(this);
 }
 
 void Plot::replot()
 {
 	//qWarning() << "Plot::replot()";
 
+	// setAxisScale() only invalidates the axes, the new intervals are
+	// calculated by updateAxes().
+	updateAxes();
+
 	for (const auto &curve_data : curve_datas_) {
 		painted_points_map_[curve_data] = 0;
+
+		// In rolling and oscilloscope mode only a small part of a time curve
+		// is visible, so only this part is handed to Qwt.
+		if (curve_data->curve_type() != CurveType::TimeCurve)
+			continue;
+		TimeCurveData *time_curve_data = (TimeCurveData *)curve_data;
+		if (update_mode_ == PlotUpdateMode::Additive) {
+			time_curve_data->clear_visible_range();
+		}
+		else {
+			QwtInterval x_interval =
+				this->axisInterval(plot_curve_map_[curve_data]->xAxis());
+			time_curve_data->set_visible_range(
+				x_interval.minValue(), x_interval.maxValue());
+		}
 	}
 
 	QwtPlot::replot();
+
+	// The axes may have changed, render a new frame with the new scale maps.
+	if (background_rendering_)
+		request_frame();
 }
 
 bool Plot::add_curve(widgets::plot::BaseCurveData *curve_data)
@@ -476,6 +521,140 @@ void Plot::set_time_span(double time_span)
 	this->replot();
 }
 
+void Plot::show_x_position(double x)
+{
+	QwtInterval x_interval = this->axisInterval(QwtPlot::xBottom);
+	double half_width = x_interval.width() / 2;
+
+	set_axis_locked(QwtPlot::xBottom, AxisBoundary::LowerBoundary, true);
+	set_axis_locked(QwtPlot::xBottom, AxisBoundary::UpperBoundary, true);
+	this->setAxisScale(QwtPlot::xBottom, x - half_width, x + half_width);
+	this->replot();
+}
+
+void Plot::set_background_rendering(bool background_rendering)
+{
+	if (background_rendering == background_rendering_)
+		return;
+	background_rendering_ = background_rendering;
+
+	if (background_rendering_) {
+		curve_renderer_ = new CurveRenderer();
+		connect(curve_renderer_, SIGNAL(frame_rendered(QImage)),
+			this, SLOT(on_frame_rendered(QImage)));
+		curve_image_item_ = new CurveImageItem();
+		// Same z order as the curves.
+		curve_image_item_->setZ(1);
+		curve_image_item_->attach(this);
+	}
+	else {
+		delete curve_renderer_;
+		curve_renderer_ = nullptr;
+		curve_image_item_->detach();
+		delete curve_image_item_;
+		curve_image_item_ = nullptr;
+		frame_rendering_ = false;
+		frame_requested_ = false;
+	}
+	frame_points_map_.clear();
+
+	replot();
+}
+
+void Plot::request_frame()
+{
+	// Only one frame is in the render thread at a time, requests in the
+	// meantime are coalesced into one new frame.
+	if (frame_rendering_) {
+		frame_requested_ = true;
+		return;
+	}
+	frame_rendering_ = true;
+	frame_requested_ = false;
+
+	// Take a snapshot of the curves in the GUI thread, the render thread
+	// only works with this copy. Only the points, that have been added since
+	// the last frame, are copied.
+	vector<curve_snapshot_t> snapshots;
+	map<plot::BaseCurveData *, frame_points_t> frame_points_map;
+	for (const auto &curve_data : curve_datas_) {
+		QwtPlotCurve *plot_curve = plot_curve_map_[curve_data];
+		if (!plot_curve->isVisible())
+			continue;
+		curve_snapshot_t snapshot;
+		const size_t num_points = curve_data->size();
+		const size_t first = curve_data->first_index();
+		const size_t end = first + num_points;
+
+		// The points of the last frame can be continued, if the range has
+		// only moved forward and the last point hasn't changed (e.g. by a
+		// new relative time offset).
+		size_t copy_from = 0;
+		snapshot.reset = true;
+		snapshot.removed_count = 0;
+		const auto it = frame_points_map_.find(curve_data);
+		if (it != frame_points_map_.end()) {
+			const frame_points_t &last = it->second;
+			if (last.end > 0 && first >= last.first && first < last.end &&
+					last.end <= end &&
+					curve_data->sample(last.end - 1 - first) == last.last_point) {
+				copy_from = last.end - first;
+				snapshot.reset = false;
+				snapshot.removed_count = (int)(first - last.first);
+			}
+		}
+
+		snapshot.curve_key = curve_data;
+		snapshot.points.reserve((int)(num_points - copy_from));
+		for (size_t i=copy_from; i<num_points; ++i)
+			snapshot.points.append(curve_data->sample(i));
+		if (num_points > 0) {
+			frame_points_map[curve_data] = { first, end,
+				curve_data->sample(num_points - 1) };
+		}
+		snapshot.x_map = canvasMap(plot_curve->xAxis());
+		snapshot.y_map = canvasMap(plot_curve->yAxis());
+		snapshot.pen = plot_curve->pen();
+		snapshot.brush = plot_curve->brush();
+		snapshot.style = plot_curve->style();
+		snapshot.antialiased =
+			plot_curve->testRenderHint(QwtPlotItem::RenderAntialiased);
+		const QwtSymbol *symbol = plot_curve->symbol();
+		snapshot.has_symbol =
+			symbol && symbol->style() != QwtSymbol::NoSymbol;
+		if (snapshot.has_symbol) {
+			snapshot.symbol_style = symbol->style();
+			snapshot.symbol_brush = symbol->brush();
+			snapshot.symbol_pen = symbol->pen();
+			snapshot.symbol_size = symbol->size();
+		}
+		painted_points_map_[curve_data] = num_points;
+		snapshots.push_back(snapshot);
+	}
+	// Curves, that are not in this frame, are discarded by the renderer.
+	frame_points_map_.swap(frame_points_map);
+
+	curve_renderer_->render(canvas()->size(), canvas()->contentsRect(),
+		std::move(snapshots));
+}
+
+void Plot::on_frame_rendered(QImage frame)
+{
+	if (!background_rendering_)
+		return;
+
+	frame_rendering_ = false;
+	curve_image_item_->set_image(frame);
+
+	// Only repaint the canvas, the scales have not changed.
+	QwtPlotCanvas *plot_canvas = qobject_cast<QwtPlotCanvas *>(canvas());
+	if (plot_canvas)
+		plot_canvas->replot();
+
+	if (frame_requested_)
+		request_frame();
+}
+
 void Plot::add_marker(plot::BaseCurveData *curve_data)
 {
 	assert(curve_data);
@@ -501,7 +680,9 @@ void Plot::add_marker(plot::BaseCurveData *curve_data)
 	double x_mid = (x_interval.minValue() + x_interval.maxValue()) / 2;
 	QwtInterval y_interval = this->axisInterval(plot_curve->yAxis());
 	double y_mid = (y_interval.minValue() + y_interval.maxValue()) / 2;
-	marker->setValue(curve_data->closest_point(QPointF(x_mid, y_mid), nullptr));
+	marker->setValue(curve_data->closest_point(QPointF(x_mid, y_mid),
+		canvasMap(plot_curve->xAxis()), canvasMap(plot_curve->yAxis()),
+		nullptr));
 
 	// Label
 	QwtText marker_label = QwtText(marker_name);
@@ -632,7 +813,10 @@ void Plot::on_marker_moved(const QPointF mouse_pos)
 		return;
 
 	plot::BaseCurveData *curve_data = marker_map_[active_marker_];
-	QPointF marker_pos = curve_data->closest_point(mouse_pos, nullptr);
+	QwtPlotCurve *plot_curve = plot_curve_map_[curve_data];
+	QPointF marker_pos = curve_data->closest_point(mouse_pos,
+		canvasMap(plot_curve->xAxis()), canvasMap(plot_curve->yAxis()),
+		nullptr);
 	active_marker_->setValue(marker_pos);
 
 	update_markers_label();
@@ -653,6 +837,17 @@ void Plot::on_legend_clicked(const QVariant &item_info, int index)
 
 void Plot::update_curves()
 {
+	if (background_rendering_) {
+		// Only request a new frame, when there are new samples.
+		for (const auto &curve_data : curve_datas_) {
+			if (curve_data->size() != painted_points_map_[curve_data]) {
+				request_frame();
+				break;
+			}
+		}
+		return;
+	}
+
 	for (const auto &curve_data : curve_datas_) {
 		const size_t painted_points = painted_points_map_[curve_data];
 		const size_t num_points = curve_data->size();
@@ -694,20 +889,103 @@ void Plot::update_curves()
 
 void Plot::update_intervals()
 {
+	bool x_interval_changed = false;
 	bool intervals_changed = false;
 
+	QwtInterval x_interval = this->axisInterval(QwtPlot::xBottom);
 	for (const auto &curve_data : curve_datas_) {
-		if (update_x_interval(curve_data))
-			intervals_changed = true;
+		if (update_x_interval(curve_data, x_interval))
+			x_interval_changed = true;
+	}
+
+	// The visible y autoscale needs the new x interval, so the y intervals
+	// are updated after all x intervals.
+	set<int> visible_y_axis_ids;
+	for (const auto &curve_data : curve_datas_) {
+		if (visible_y_autoscale_ &&
+				curve_data->curve_type() == CurveType::TimeCurve) {
+			visible_y_axis_ids.insert(y_axis_id_map_[curve_data]);
+			continue;
+		}
 		if (update_y_interval(curve_data))
 			intervals_changed = true;
 	}
+	for (const int y_axis_id : visible_y_axis_ids) {
+		if (update_y_interval_visible(y_axis_id, x_interval))
+			intervals_changed = true;
+	}
 
-	if (intervals_changed)
+	// When only the x axis has moved on in rolling mode, the canvas is
+	// scrolled instead of replotting all curves.
+	if (x_interval_changed && !intervals_changed && scroll_canvas())
+		return;
+	if (x_interval_changed || intervals_changed)
 		replot();
 }
 
-bool Plot::update_x_interval(plot::BaseCurveData *curve_data)
+bool Plot::scroll_canvas()
+{
+	// Overlays with a fixed canvas position (markers label) and frames from
+	// the render thread can't be scrolled.
+	if (update_mode_ != PlotUpdateMode::Rolling || background_rendering_ ||
+			!markers_.empty())
+		return false;
+	for (const auto &curve_data : curve_datas_) {
+		if (curve_data->curve_type() != CurveType::TimeCurve)
+			return false;
+	}
+
+	// The new samples must be painted with the old scale maps, so they are
+	// scrolled together with the rest of the canvas.
+	const QwtScaleMap old_x_map = canvasMap(QwtPlot::xBottom);
+	update_curves();
+
+	updateAxes();
+	const QwtScaleMap x_map = canvasMap(QwtPlot::xBottom);
+	if (x_map.p1() != old_x_map.p1() || x_map.p2() != old_x_map.p2() ||
+			std::fabs(x_map.sDist() - old_x_map.sDist()) >
+				std::fabs(old_x_map.sDist()) * 1e-9)
+		return false;
+
+	// The x axis has been moved by whole pixels in update_x_interval().
+	const double dx = old_x_map.transform(x_map.s1()) - x_map.p1();
+	const int scroll = qRound(dx);
+	if (scroll <= 0 || std::fabs(dx - scroll) > 0.01)
+		return false;
+
+	// The rounded corners of the canvas must not be scrolled.
+	const QRect rect = canvas()->contentsRect();
+	int radius = 0;
+	QwtPlotCanvas *plot_canvas = qobject_cast<QwtPlotCanvas *>(canvas());
+	if (plot_canvas)
+		radius = (int)std::ceil(plot_canvas->borderRadius());
+	const QRect scroll_rect = rect.adjusted(radius, 0, -radius, 0);
+	if (scroll >= scroll_rect.width())
+		return false;
+
+	canvas()->scroll(-scroll, 0, scroll_rect);
+
+	// Repaint the exposed strip and the rounded corners synchronously, only
+	// the samples inside these rects are painted (see drawItems()).
+	scroll_rects_.clear();
+	scroll_rects_.push_back(QRect(rect.left(), rect.top(),
+		radius, rect.height()));
+	scroll_rects_.push_back(QRect(scroll_rect.right() - scroll + 1,
+		rect.top(), scroll + radius, rect.height()));
+	QRegion region;
+	for (const auto &repaint_rect : scroll_rects_)
+		region += repaint_rect;
+	canvas()->repaint(region);
+	scroll_rects_.clear();
+
+	for (const auto &curve_data : curve_datas_)
+		painted_points_map_[curve_data] = curve_data->size();
+
+	return true;
+}
+
+bool Plot::update_x_interval(plot::BaseCurveData *curve_data,
+	QwtInterval &x_interval)
 {
 	if (axis_lock_map_[QwtPlot::xBottom][AxisBoundary::LowerBoundary] &&
 		axis_lock_map_[QwtPlot::xBottom][AxisBoundary::UpperBoundary])
@@ -715,7 +993,6 @@ bool Plot::update_x_interval(plot::BaseCurveData *curve_data)
 
 	bool interval_changed = false;
 	QRectF boundaries = curve_data->boundingRect();
-	QwtInterval x_interval = this->axisInterval(QwtPlot::xBottom);
 	double min = x_interval.minValue();
 	double max = x_interval.maxValue();
 
@@ -762,10 +1039,19 @@ bool Plot::update_x_interval(plot::BaseCurveData *curve_data)
 		if (boundaries.right() <= max)
 			return false;
 
-		if (boundaries.right() > max+time_span_)
+		if (boundaries.right() > max+time_span_) {
 			min = boundaries.right();
-		else
-			min += add_time_;
+		}
+		else {
+			// Move the axis by whole pixels, so the content of the canvas
+			// can be scrolled (see scroll_canvas()).
+			const QwtScaleMap x_map = canvasMap(QwtPlot::xBottom);
+			const double pixel_width = x_map.sDist() / x_map.pDist();
+			if (pixel_width > 0)
+				min += std::ceil(add_time_ / pixel_width) * pixel_width;
+			else
+				min += add_time_;
+		}
 		max = min + time_span_;
 
 		interval_changed = true;
@@ -803,6 +1089,8 @@ bool Plot::update_x_interval(plot::BaseCurveData *curve_data)
 		painted_points_map_[curve_data] = 0;
 	}
 
+	if (interval_changed)
+		x_interval = QwtInterval(min, max);
 	return interval_changed;
 }
 
@@ -837,6 +1125,69 @@ bool Plot::update_y_interval(plot::BaseCurveData *curve_data)
 	return interval_changed;
 }
 
+bool Plot::update_y_interval_visible(int y_axis_id,
+	const QwtInterval &x_interval)
+{
+	if (axis_lock_map_[y_axis_id][AxisBoundary::LowerBoundary] &&
+			axis_lock_map_[y_axis_id][AxisBoundary::UpperBoundary])
+		return false;
+
+	// Min/max of all time curves on this axis in the visible x range
+	bool found = false;
+	double min = 0.;
+	double max = 0.;
+	for (const auto &curve_data : curve_datas_) {
+		if (curve_data->curve_type() != CurveType::TimeCurve ||
+				y_axis_id_map_[curve_data] != y_axis_id)
+			continue;
+
+		double curve_min;
+		double curve_max;
+		if (!((TimeCurveData *)curve_data)->value_range(
+				x_interval.minValue(), x_interval.maxValue(),
+				curve_min, curve_max))
+			continue;
+		if (!found || curve_min < min)
+			min = curve_min;
+		if (!found || curve_max > max)
+			max = curve_max;
+		found = true;
+	}
+	if (!found)
+		return false;
+
+	// 10% of the data range as margin
+	double margin = (max - min) * 0.1;
+	if (margin <= 0)
+		margin = std::fabs(max) * 0.1;
+	if (margin <= 0)
+		margin = 1.;
+
+	// Grow the interval immediately, but shrink it only, when the visible
+	// data uses less than half of the axis. This avoids a replot on every
+	// timer tick.
+	QwtInterval y_interval = this->axisInterval(y_axis_id);
+	double y_min = y_interval.minValue();
+	double y_max = y_interval.maxValue();
+	const bool shrink = (max - min + 2 * margin) < y_interval.width() * 0.5;
+	bool interval_changed = false;
+
+	if (!axis_lock_map_[y_axis_id][AxisBoundary::LowerBoundary] &&
+			(min < y_min || shrink)) {
+		y_min = min - margin;
+		interval_changed = true;
+	}
+	if (!axis_lock_map_[y_axis_id][AxisBoundary::UpperBoundary] &&
+			(max > y_max || shrink)) {
+		y_max = max + margin;
+		interval_changed = true;
+	}
+
+	if (interval_changed)
+		setAxisScale(y_axis_id, y_min, y_max);
+	return interval_changed;
+}
+
 void Plot::set_markers_label_alignment(int alignment)
 {
 	markers_label_alignment_ = alignment;
@@ -918,15 +1269,10 @@ void Plot::update_markers_label()
 	markers_label_->setText(text);
 }
 
-void Plot::timerEvent(QTimerEvent *event)
+void Plot::update_plot()
 {
-	if (event->timerId() == timer_id_) {
-		update_intervals();
-		update_curves();
-		return;
-	}
-
-	QwtPlot::timerEvent(event);
+	update_intervals();
+	update_curves();
 }
 
 void Plot::resizeEvent(QResizeEvent *event)
@@ -936,14 +1282,84 @@ void Plot::resizeEvent(QResizeEvent *event)
 	}
 
 	QwtPlot::resizeEvent(event);
+
+	if (background_rendering_)
+		request_frame();
 }
 
 void Plot::showEvent(QShowEvent *event)
 {
 	(void)event;
+
+	// Catch up with the samples, that were added while the plot was hidden,
+	// in a single step.
+	if (is_running_) {
+		PlotScheduler::instance()->add_plot(this);
+		update_intervals();
+	}
 	replot();
 }
 
+void Plot::hideEvent(QHideEvent *event)
+{
+	// No updates for hidden plots (e.g. in an inactive tab).
+	PlotScheduler::instance()->remove_plot(this);
+
+	QwtPlot::hideEvent(event);
+}
+
+void Plot::drawItems(QPainter *painter, const QRectF &canvas_rect,
+	const QwtScaleMap maps[axisCnt]) const
+{
+	// When rendering in background, the curves are not painted onto the
+	// canvas by the GUI thread, the finished frame is drawn instead. When
+	// rendering to another device (e.g. saving the plot), the curves are
+	// painted as usual.
+	const bool draw_frame =
+		background_rendering_ && painter->device() == canvas();
+
+	for (const auto &item : itemList()) {
+		if (!item || !item->isVisible())
+			continue;
+		if (draw_frame && item->rtti() == QwtPlotItem::Rtti_PlotCurve)
+			continue;
+		if (!draw_frame && item == curve_image_item_)
+			continue;
+
+		// After scrolling the canvas, only the samples of the time curves
+		// in the repainted rects are painted.
+		TimeCurveData *time_curve_data = nullptr;
+		if (!scroll_rects_.empty() && painter->device() == canvas() &&
+				item->rtti() == QwtPlotItem::Rtti_PlotCurve) {
+			time_curve_data = dynamic_cast<TimeCurveData *>(
+				((QwtPlotCurve *)item)->data());
+		}
+		if (time_curve_data) {
+			const QwtScaleMap &x_map = maps[item->xAxis()];
+			for (const auto &rect : scroll_rects_) {
+				time_curve_data->set_visible_range(
+					x_map.invTransform(rect.left()),
+					x_map.invTransform(rect.right() + 1));
+				painter->save();
+				painter->setClipRect(rect, Qt::IntersectClip);
+				painter->setRenderHint(QPainter::Antialiasing,
+					item->testRenderHint(QwtPlotItem::RenderAntialiased));
+				item->draw(painter, x_map, maps[item->yAxis()], canvas_rect);
+				painter->restore();
+			}
+			time_curve_data->set_visible_range(x_map.s1(), x_map.s2());
+			continue;
+		}
+
+		painter->save();
+		painter->setRenderHint(QPainter::Antialiasing,
+			item->testRenderHint(QwtPlotItem::RenderAntialiased));
+		item->draw(painter,
+			maps[item->xAxis()], maps[item->yAxis()], canvas_rect);
+		painter->restore();
+	}
+}
+
 bool Plot::eventFilter(QObject *object, QEvent *event)
 {
 	return QwtPlot::eventFilter(object, event);
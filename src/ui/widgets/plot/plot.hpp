@@ -22,8 +22,11 @@
 #define UI_WIDGETS_PLOT_PLOT_HPP
 
 #include <map>
+#include <set>
 #include <vector>
 
+#include <QImage>
+#include <QRect>
 #include <QVariant>
 
 #include <qwt_interval.h>
@@ -39,6 +42,7 @@
 
 using std::map;
 using std::pair;
+using std::set;
 using std::vector;
 
 namespace sv {
@@ -47,6 +51,8 @@ namespace widgets {
 namespace plot {
 
 class BaseCurveData;
+class CurveImageItem;
+class CurveRenderer;
 class PlotMagnifier;
 
 enum class AxisBoundary {
@@ -79,20 +85,43 @@ public:
 	virtual ~Plot();
 
 	virtual void replot() override;
+	virtual void drawItems(QPainter *painter, const QRectF &canvas_rect,
+		const QwtScaleMap maps[axisCnt]) const override;
 	virtual bool eventFilter(QObject * object, QEvent *event) override;
 	bool add_curve(plot::BaseCurveData *curve_data);
 	vector<plot::BaseCurveData *> curve_datas() { return curve_datas_; }
 	bool is_axis_locked(int axis_id, AxisBoundary axis_boundary) { return axis_lock_map_[axis_id][axis_boundary]; }
 	void set_axis_locked(int axis_id, AxisBoundary axis_boundary, bool locked);
 	void set_all_axis_locked(bool locked);
-	void set_plot_interval(int plot_interval) { plot_interval_ = plot_interval; }
 	void set_update_mode(PlotUpdateMode update_mode) { update_mode_ = update_mode; }
 	PlotUpdateMode update_mode() const { return update_mode_; };
 	void set_time_span(double time_span);
 	double time_span() { return time_span_; }
 	void set_add_time(double add_time) { add_time_ = add_time; }
 	double add_time() { return add_time_; }
+	/**
+	 * Center the x axis at the given position (keeping the current width)
+	 * and lock the x axis, so the view isn't moved by new samples.
+	 */
+	void show_x_position(double x);
+	/**
+	 * Render the curves in a background thread into an image. The GUI
+	 * thread only draws the finished image.
+	 */
+	void set_background_rendering(bool background_rendering);
+	bool background_rendering() const { return background_rendering_; }
+	/**
+	 * Update the axis intervals and paint the new samples. This is called
+	 * by the PlotScheduler.
+	 */
+	void update_plot();
 	map<QwtPlotMarker *, plot::BaseCurveData *> markers() { return marker_map_; }
+	/**
+	 * Scale the y axes of time curves to the samples in the visible x range,
+	 * instead of all samples of the signals.
+	 */
+	void set_visible_y_autoscale(bool visible_y_autoscale) { visible_y_autoscale_ = visible_y_autoscale; }
+	bool visible_y_autoscale() const { return visible_y_autoscale_; }
 	void set_markers_label_alignment(int alignment);
 	int markers_label_alignment() { return markers_label_alignment_; }
 
@@ -110,20 +139,31 @@ public Q_SLOTS:
 	void on_marker_selected(const QPointF mouse_pos);
 	void on_marker_moved(const QPointF mouse_pos);
 	void on_legend_clicked(const QVariant &item_info, int index);
+	void on_frame_rendered(QImage frame);
 
 Q_SIGNALS:
 	void axis_lock_changed(int axis_id, AxisBoundary axis_boundary, bool locked);
 
 protected:
 	virtual void showEvent(QShowEvent *event) override;
+	virtual void hideEvent(QHideEvent *event) override;
 	virtual void resizeEvent(QResizeEvent *event) override;
-	virtual void timerEvent(QTimerEvent *event) override;
 
 private:
 	void update_curves();
+	void request_frame();
 	void update_intervals();
-	bool update_x_interval(plot::BaseCurveData *curve_data);
+	/**
+	 * Update the x interval for the curve. x_interval is the current x
+	 * interval and is set to the new interval, because axisInterval() returns
+	 * the new interval only after updateAxes().
+	 */
+	bool update_x_interval(plot::BaseCurveData *curve_data,
+		QwtInterval &x_interval);
 	bool update_y_interval(plot::BaseCurveData *curve_data);
+	bool update_y_interval_visible(int y_axis_id,
+		const QwtInterval &x_interval);
+	bool scroll_canvas();
 	void update_markers_label();
 
 	vector<plot::BaseCurveData *> curve_datas_;
@@ -131,10 +171,19 @@ private:
 	map<plot::BaseCurveData *, QwtPlotDirectPainter *> plot_direct_painter_map_;
 	map<plot::BaseCurveData *, int> y_axis_id_map_;
 	map<plot::BaseCurveData *, size_t> painted_points_map_;
+	/**
+	 * The points of a curve, that have been handed to the render thread,
+	 * as range of the curve data.
+	 */
+	struct frame_points_t
+	{
+		size_t first;
+		size_t end;
+		QPointF last_point;
+	};
+	map<plot::BaseCurveData *, frame_points_t> frame_points_map_;
 
 	map<int, map<AxisBoundary, bool>> axis_lock_map_; // map<axis_id, map<AxisBoundary, locked>>
-	int plot_interval_;
-	int timer_id_;
 	PlotUpdateMode update_mode_;
 	double time_span_;
 	double add_time_;
@@ -151,6 +200,16 @@ private:
 	QwtPlotPicker *marker_select_picker_;
 	QwtPlotPicker *marker_move_picker_;
 
+	bool background_rendering_;
+	CurveRenderer *curve_renderer_;
+	CurveImageItem *curve_image_item_;
+	bool frame_rendering_;
+	bool frame_requested_;
+	bool is_running_;
+	bool visible_y_autoscale_;
+	/** Canvas rects, that are repainted after scrolling the canvas */
+	vector<QRect> scroll_rects_;
+
 };
 
 } // namespace plot
@@ -0,0 +1,162 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2020 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <vector>
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QTimer>
+
+#include "plotscheduler.hpp"
+#include "src/ui/widgets/plot/plot.hpp"
+
+/** Maximum part of the GUI thread time used for plot updates */
+#define PLOT_LOAD_LIMIT 0.5
+/** Maximum update interval in ms, even under heavy load */
+#define PLOT_MAX_INTERVAL 2000.
+/** Weight of a new measurement for the smoothed tick cost */
+#define PLOT_COST_SMOOTHING 0.25
+
+using std::vector;
+
+namespace sv {
+namespace ui {
+namespace widgets {
+namespace plot {
+
+PlotScheduler *PlotScheduler::instance()
+{
+	// The scheduler is deleted together with the application object.
+	static PlotScheduler *scheduler =
+		new PlotScheduler(QCoreApplication::instance());
+	return scheduler;
+}
+
+PlotScheduler::PlotScheduler(QObject *parent) :
+	QObject(parent),
+	next_plot_pos_(0),
+	target_interval_(200.), // 5 fps
+	interval_(200.),
+	tick_cost_(0.)
+{
+	timer_.setSingleShot(true);
+	timer_.setTimerType(Qt::PreciseTimer);
+	connect(&timer_, SIGNAL(timeout()), this, SLOT(on_tick()));
+}
+
+void PlotScheduler::add_plot(Plot *plot)
+{
+	assert(plot);
+
+	if (std::find(plots_.begin(), plots_.end(), plot) != plots_.end())
+		return;
+	plots_.push_back(plot);
+
+	if (!timer_.isActive())
+		schedule_next_tick();
+}
+
+void PlotScheduler::remove_plot(Plot *plot)
+{
+	auto it = std::find(plots_.begin(), plots_.end(), plot);
+	if (it == plots_.end())
+		return;
+	plots_.erase(it);
+
+	if (next_plot_pos_ >= plots_.size())
+		next_plot_pos_ = 0;
+	if (plots_.empty())
+		timer_.stop();
+}
+
+void PlotScheduler::set_target_frame_rate(double frame_rate)
+{
+	assert(frame_rate > 0);
+
+	target_interval_ = 1000. / frame_rate;
+	interval_ = std::max(target_interval_, interval_);
+	if (timer_.isActive())
+		schedule_next_tick();
+}
+
+double PlotScheduler::target_frame_rate() const
+{
+	return 1000. / target_interval_;
+}
+
+double PlotScheduler::frame_rate() const
+{
+	return 1000. / interval_;
+}
+
+double PlotScheduler::tick_cost() const
+{
+	return tick_cost_;
+}
+
+void PlotScheduler::schedule_next_tick()
+{
+	timer_.start((int)std::lround(interval_));
+}
+
+void PlotScheduler::on_tick()
+{
+	if (plots_.empty())
+		return;
+
+	// Update as many plots as fit into the frame budget, but at least one.
+	// The plots that didn't fit are updated first in the next tick.
+	const double budget = interval_ * PLOT_LOAD_LIMIT;
+	const size_t plot_count = plots_.size();
+	QElapsedTimer elapsed;
+	elapsed.start();
+	size_t updated = 0;
+	while (updated < plot_count) {
+		Plot *plot = plots_[next_plot_pos_];
+		next_plot_pos_ = (next_plot_pos_ + 1) % plot_count;
+		plot->update_plot();
+		++updated;
+
+		if ((double)elapsed.nsecsElapsed() / 1e6 > budget)
+			break;
+	}
+	double cost = (double)elapsed.nsecsElapsed() / 1e6;
+
+	// Scale the cost of a partial tick to the cost of a full tick.
+	cost = cost * (double)plot_count / (double)updated;
+	tick_cost_ = PLOT_COST_SMOOTHING * cost +
+		(1. - PLOT_COST_SMOOTHING) * tick_cost_;
+
+	// Adapt the interval, so the updates only use PLOT_LOAD_LIMIT of the time.
+	double old_interval = interval_;
+	interval_ = std::max(target_interval_, tick_cost_ / PLOT_LOAD_LIMIT);
+	interval_ = std::min(interval_, PLOT_MAX_INTERVAL);
+	if (std::fabs(interval_ - old_interval) > 1.)
+		Q_EMIT frame_rate_changed(frame_rate());
+
+	schedule_next_tick();
+}
+
+} // namespace plot
+} // namespace widgets
+} // namespace ui
+} // namespace sv
@@ -0,0 +1,99 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2020 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UI_WIDGETS_PLOT_PLOTSCHEDULER_HPP
+#define UI_WIDGETS_PLOT_PLOTSCHEDULER_HPP
+
+#include <vector>
+
+#include <QObject>
+#include <QTimer>
+
+using std::vector;
+
+namespace sv {
+namespace ui {
+namespace widgets {
+namespace plot {
+
+class Plot;
+
+/**
+ * Drives the updates of all plots with one timer.
+ *
+ * All plots are updated in the same tick. The time the updates take is
+ * measured and the interval between the ticks is adapted, so that the plot
+ * updates only use a part of the GUI thread (PLOT_LOAD_LIMIT). Under load the
+ * frame rate drops below the target frame rate, when the load decreases the
+ * frame rate goes back to the target. If a tick exceeds the frame budget,
+ * the remaining plots are updated first in the next tick, so no plot starves.
+ */
+class PlotScheduler : public QObject
+{
+	Q_OBJECT
+
+public:
+	/**
+	 * Return the scheduler that is shared by all plots.
+	 */
+	static PlotScheduler *instance();
+
+	void add_plot(Plot *plot);
+	void remove_plot(Plot *plot);
+
+	/**
+	 * Set the target (maximum) frame rate in frames per second.
+	 */
+	void set_target_frame_rate(double frame_rate);
+	double target_frame_rate() const;
+	/**
+	 * Return the current (adapted) frame rate in frames per second.
+	 */
+	double frame_rate() const;
+	/**
+	 * Return the (smoothed) time in ms, that one tick takes.
+	 */
+	double tick_cost() const;
+
+private:
+	PlotScheduler(QObject *parent = nullptr);
+
+	void schedule_next_tick();
+
+	vector<Plot *> plots_;
+	size_t next_plot_pos_;
+	QTimer timer_;
+	double target_interval_;
+	double interval_;
+	double tick_cost_;
+
+private Q_SLOTS:
+	void on_tick();
+
+Q_SIGNALS:
+	void frame_rate_changed(double frame_rate);
+
+};
+
+} // namespace plot
+} // namespace widgets
+} // namespace ui
+} // namespace sv
+
+#endif // UI_WIDGETS_PLOT_PLOTSCHEDULER_HPP
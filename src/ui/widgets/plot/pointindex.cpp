@@ -0,0 +1,163 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2020 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include "pointindex.hpp"
+
+using std::shared_ptr;
+using std::vector;
+
+namespace sv {
+namespace ui {
+namespace widgets {
+namespace plot {
+
+PointIndex::PointIndex(shared_ptr<vector<double>> x_data,
+		shared_ptr<vector<double>> y_data) :
+	x_data_(x_data),
+	y_data_(y_data),
+	tail_start_(0),
+	indexed_end_(0)
+{
+}
+
+void PointIndex::update()
+{
+	indexed_end_ = std::min(x_data_->size(), y_data_->size());
+
+	// Move full tails into the trees and merge trees of the same size.
+	while (indexed_end_ - tail_start_ >= tail_size_) {
+		vector<size_t> tree;
+		for (size_t i=tail_start_; i<tail_start_+tail_size_; ++i)
+			tree.push_back(i);
+		tail_start_ += tail_size_;
+
+		size_t level = 0;
+		while (level < trees_.size() && !trees_[level].empty()) {
+			tree.insert(tree.end(), trees_[level].begin(), trees_[level].end());
+			trees_[level].clear();
+			++level;
+		}
+		if (level >= trees_.size())
+			trees_.resize(level + 1);
+
+		build(tree, 0, tree.size(), 0);
+		trees_[level].swap(tree);
+	}
+}
+
+void PointIndex::clear()
+{
+	trees_.clear();
+	tail_start_ = 0;
+	indexed_end_ = 0;
+}
+
+size_t PointIndex::size() const
+{
+	return indexed_end_;
+}
+
+long PointIndex::nearest(double x, double y, double x_scale, double y_scale,
+	double *dist) const
+{
+	query_t query = { x, y, x_scale, y_scale,
+		0, std::numeric_limits<double>::infinity() };
+
+	for (size_t i=tail_start_; i<indexed_end_; ++i)
+		check_point(i, query);
+	for (const auto &tree : trees_) {
+		if (!tree.empty())
+			search(tree, 0, tree.size(), 0, query);
+	}
+
+	if (std::isinf(query.best_dist_sq))
+		return -1;
+	if (dist)
+		*dist = sqrt(query.best_dist_sq);
+	return (long)query.best_index;
+}
+
+void PointIndex::build(vector<size_t> &tree, size_t lo, size_t hi, int axis)
+{
+	// Implicit tree: The median of [lo, hi) is the node, the lower half is
+	// the left and the upper half the right subtree.
+	if (hi - lo <= 1)
+		return;
+
+	const vector<double> &data = axis == 0 ? *x_data_ : *y_data_;
+	size_t mid = lo + (hi - lo) / 2;
+	std::nth_element(tree.begin() + lo, tree.begin() + mid, tree.begin() + hi,
+		[&data](size_t a, size_t b) { return data[a] < data[b]; });
+
+	build(tree, lo, mid, 1 - axis);
+	build(tree, mid + 1, hi, 1 - axis);
+}
+
+void PointIndex::search(const vector<size_t> &tree, size_t lo, size_t hi,
+	int axis, query_t &query) const
+{
+	if (lo >= hi)
+		return;
+
+	size_t mid = lo + (hi - lo) / 2;
+	size_t index = tree[mid];
+	check_point(index, query);
+
+	double diff;
+	if (axis == 0)
+		diff = (query.x - (*x_data_)[index]) * query.x_scale;
+	else
+		diff = (query.y - (*y_data_)[index]) * query.y_scale;
+
+	// Search the side of the query point first, the other side only if the
+	// splitting line is nearer than the best point so far.
+	if (diff < 0) {
+		search(tree, lo, mid, 1 - axis, query);
+		if (diff * diff < query.best_dist_sq)
+			search(tree, mid + 1, hi, 1 - axis, query);
+	}
+	else {
+		search(tree, mid + 1, hi, 1 - axis, query);
+		if (diff * diff < query.best_dist_sq)
+			search(tree, lo, mid, 1 - axis, query);
+	}
+}
+
+void PointIndex::check_point(size_t index, query_t &query) const
+{
+	const double dx = ((*x_data_)[index] - query.x) * query.x_scale;
+	const double dy = ((*y_data_)[index] - query.y) * query.y_scale;
+	const double d = dx * dx + dy * dy;
+	if (d < query.best_dist_sq) {
+		query.best_index = index;
+		query.best_dist_sq = d;
+	}
+}
+
+} // namespace plot
+} // namespace widgets
+} // namespace ui
+} // namespace sv
@@ -0,0 +1,111 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2020 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UI_WIDGETS_PLOT_POINTINDEX_HPP
+#define UI_WIDGETS_PLOT_POINTINDEX_HPP
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+using std::shared_ptr;
+using std::vector;
+
+namespace sv {
+namespace ui {
+namespace widgets {
+namespace plot {
+
+/**
+ * Spatial index for the nearest point search in x/y data, that is only
+ * appended to.
+ *
+ * The index is a set of static, balanced k-d trees with power of two sizes
+ * (logarithmic method). New points are collected in a small tail that is
+ * searched linearly. When the tail is full, it becomes a new tree and trees
+ * of the same size are merged, like the carry of a binary counter. Appending
+ * is amortized O(log^2 n), a query is O(log^2 n).
+ *
+ * The distance is weighted per axis (x_scale and y_scale, e.g. pixels per
+ * unit), so the nearest point is found in screen space, also for plots with
+ * very different axis scales.
+ */
+class PointIndex
+{
+
+public:
+	PointIndex(shared_ptr<vector<double>> x_data,
+		shared_ptr<vector<double>> y_data);
+
+	/**
+	 * Add all points from the data vectors, that are not yet indexed.
+	 */
+	void update();
+
+	/**
+	 * Remove all points from the index.
+	 */
+	void clear();
+
+	/**
+	 * Return the number of indexed points.
+	 */
+	size_t size() const;
+
+	/**
+	 * Return the index of the point that is nearest to (x, y) or -1 if the
+	 * index is empty. dist is set to the weighted distance.
+	 */
+	long nearest(double x, double y, double x_scale, double y_scale,
+		double *dist) const;
+
+private:
+	struct query_t {
+		double x;
+		double y;
+		double x_scale;
+		double y_scale;
+		size_t best_index;
+		double best_dist_sq;
+	};
+
+	void build(vector<size_t> &tree, size_t lo, size_t hi, int axis);
+	void search(const vector<size_t> &tree, size_t lo, size_t hi, int axis,
+		query_t &query) const;
+	void check_point(size_t index, query_t &query) const;
+
+	shared_ptr<vector<double>> x_data_;
+	shared_ptr<vector<double>> y_data_;
+	/** The trees, trees_[k] is empty or has (tail_size_ << k) points. */
+	vector<vector<size_t>> trees_;
+	/** First point in the data vectors that isn't stored in a tree. */
+	size_t tail_start_;
+	/** Last point in the data vectors that is indexed. */
+	size_t indexed_end_;
+
+	static const size_t tail_size_ = 64;
+
+};
+
+} // namespace plot
+} // namespace widgets
+} // namespace ui
+} // namespace sv
+
+#endif // UI_WIDGETS_PLOT_POINTINDEX_HPP
@@ -18,7 +18,9 @@
  */
 
 #include <memory>
+#include <algorithm>
 #include <set>
+#include <vector>
 
 #include <QPointF>
 #include <QRectF>
@@ -39,8 +41,16 @@ namespace plot {
 
 TimeCurveData::TimeCurveData(shared_ptr<sv::data::AnalogTimeSignal> signal) :
 	BaseCurveData(CurveType::TimeCurve),
-	signal_(signal)
+	signal_(signal),
+	time_data_(signal->time_data()),
+	value_data_(signal->value_data()),
+	time_offset_(0.),
+	range_first_(0),
+	range_end_(0),
+	range_open_end_(true),
+	min_max_index_(value_data_)
 {
+	update_time_offset();
 }
 
 bool TimeCurveData::is_equal(const BaseCurveData *other) const
@@ -54,20 +64,27 @@ bool TimeCurveData::is_equal(const BaseCurveData *other) const
 
 QPointF TimeCurveData::sample(size_t i) const
 {
-	//signal_data_->lock();
-
-	auto sample = signal_->get_sample(i, relative_time_);
-	QPointF sample_point(sample.first, sample.second);
-
-	//signal_data_->.unlock();
-
-	return sample_point;
+	// i is always < size(), so no bounds checking is needed here.
+	const size_t pos = range_first_ + i;
+	return QPointF(time_data_[pos] - time_offset_, value_data_[pos]);
 }
 
 size_t TimeCurveData::size() const
 {
+	update_time_offset();
+
 	// TODO: Synchronize x/y sample data
-	return signal_->sample_count();
+	const size_t sample_count = signal_->sample_count();
+	const size_t first = std::min(range_first_, sample_count);
+	size_t end = sample_count;
+	if (!range_open_end_)
+		end = std::min(range_end_, sample_count);
+	return end - first;
+}
+
+size_t TimeCurveData::first_index() const
+{
+	return std::min(range_first_, signal_->sample_count());
 }
 
 QRectF TimeCurveData::boundingRect() const
@@ -89,37 +106,27 @@ QRectF TimeCurveData::boundingRect() const
 		QPointF(signal_->last_timestamp(relative_time_), signal_->min_value()));
 }
 
-QPointF TimeCurveData::closest_point(const QPointF &pos, double *dist) const
+QPointF TimeCurveData::closest_point(const QPointF &pos,
+	const QwtScaleMap &x_map, const QwtScaleMap &y_map, double *dist) const
 {
+	(void)x_map;
+	(void)y_map;
 	(void)dist;
-	const double x_value = pos.x();
-	const int index_max = (int)size() - 1;
-
-	// Corner cases
-	if (index_max < 0)
+	update_time_offset();
+	const size_t num_samples = signal_->sample_count();
+	if (num_samples == 0)
 		return QPointF(0, 0);
-	if (x_value <= sample(0).x())
-		return sample(0);
-	if (x_value >= sample(index_max).x())
-		return sample(index_max);
-
-	size_t index_min = 0;
-	size_t n = index_max;
-
-	while (n > 0) {
-		const size_t half = n >> 1;
-		const size_t index_mid = index_min + half;
 
-		if (x_value < sample(index_mid).x()) {
-			n = half;
-		}
-		else {
-			index_min = index_mid + 1;
-			n -= half + 1;
-		}
-	}
+	// Search the absolute timestamp directly in the time data of the signal.
+	// The whole signal is searched, not only the visible range.
+	const double timestamp = pos.x() + time_offset_;
+	auto begin = time_data_.begin();
+	auto it = std::upper_bound(begin, begin + num_samples, timestamp);
+	if (it == begin + num_samples)
+		--it;
 
-	return sample(index_min);
+	const size_t index = it - begin;
+	return QPointF(time_data_[index] - time_offset_, value_data_[index]);
 }
 
 QString TimeCurveData::name() const
@@ -187,6 +194,57 @@ shared_ptr<sv::data::AnalogTimeSignal> TimeCurveData::signal() const
 	return signal_;
 }
 
+void TimeCurveData::set_visible_range(double x_min, double x_max)
+{
+	update_time_offset();
+	const size_t num_samples = signal_->sample_count();
+	auto begin = time_data_.begin();
+	auto end = begin + num_samples;
+
+	// One additional point on each side, so the line is continued to the
+	// borders of the canvas.
+	auto first = std::lower_bound(begin, end, x_min + time_offset_);
+	range_first_ = first - begin;
+	if (range_first_ > 0)
+		--range_first_;
+
+	auto last = std::upper_bound(first, end, x_max + time_offset_);
+	range_end_ = last - begin;
+	if (range_end_ < num_samples)
+		++range_end_;
+	range_open_end_ = range_end_ >= num_samples;
+}
+
+void TimeCurveData::clear_visible_range()
+{
+	range_first_ = 0;
+	range_end_ = 0;
+	range_open_end_ = true;
+}
+
+bool TimeCurveData::value_range(double x_min, double x_max,
+	double &min, double &max) const
+{
+	update_time_offset();
+	const size_t num_samples = signal_->sample_count();
+	min_max_index_.update(num_samples);
+
+	auto begin = time_data_.begin();
+	auto end = begin + num_samples;
+	auto first = std::lower_bound(begin, end, x_min + time_offset_);
+	auto last = std::upper_bound(first, end, x_max + time_offset_);
+
+	return min_max_index_.min_max(first - begin, last - begin, min, max);
+}
+
+void TimeCurveData::update_time_offset() const
+{
+	if (relative_time_)
+		time_offset_ = signal_->signal_start_timestamp();
+	else
+		time_offset_ = 0.;
+}
+
 } // namespace plot
 } // namespace widgets
 } // namespace ui
@@ -22,6 +22,7 @@
 
 #include <memory>
 #include <set>
+#include <vector>
 
 #include <QPointF>
 #include <QRectF>
@@ -29,9 +30,11 @@
 
 #include "src/data/datautil.hpp"
 #include "src/ui/widgets/plot/basecurvedata.hpp"
+#include "src/ui/widgets/plot/minmaxindex.hpp"
 
 using std::set;
 using std::shared_ptr;
+using std::vector;
 
 namespace sv {
 
@@ -43,6 +46,16 @@ namespace ui {
 namespace widgets {
 namespace plot {
 
+/**
+ * The samples are read directly from the contiguous storage of the signal.
+ * The offset for the relative time is only looked up, when Qwt requests the
+ * size of the series (at the start of every replot/transformation), not for
+ * every single sample.
+ *
+ * The series can be limited to a visible range of the x axis (plus one point
+ * on each side for the line continuity), so Qwt doesn't have to transform
+ * and clip points that are not visible anyway.
+ */
 class TimeCurveData : public BaseCurveData
 {
 
@@ -54,8 +67,11 @@ public:
 	QPointF sample(size_t i) const override;
 	size_t size() const override;
 	QRectF boundingRect() const override;
+	size_t first_index() const override;
 
-	QPointF closest_point(const QPointF &pos, double *dist) const override;
+	QPointF closest_point(const QPointF &pos,
+		const QwtScaleMap &x_map, const QwtScaleMap &y_map,
+		double *dist) const override;
 	QString name() const override;
 	sv::data::Quantity x_quantity() const override;
 	set<sv::data::QuantityFlag> x_quantity_flags() const override;
@@ -70,8 +86,36 @@ public:
 
 	shared_ptr<sv::data::AnalogTimeSignal> signal() const;
 
+	/**
+	 * Limit the series to the samples between x_min and x_max (in the
+	 * coordinates of the curve). If x_max is after the last sample, the
+	 * range is open ended and grows with new samples.
+	 */
+	void set_visible_range(double x_min, double x_max);
+	/**
+	 * Remove the limitation of the series to a visible range.
+	 */
+	void clear_visible_range();
+
+	/**
+	 * Get the minimum and maximum value of the samples between x_min and
+	 * x_max (in the coordinates of the curve). Return false if there are no
+	 * samples in this range.
+	 */
+	bool value_range(double x_min, double x_max,
+		double &min, double &max) const;
+
 private:
+	void update_time_offset() const;
+
 	shared_ptr<sv::data::AnalogTimeSignal> signal_;
+	const vector<double> &time_data_;
+	const vector<double> &value_data_;
+	mutable double time_offset_;
+	size_t range_first_;
+	size_t range_end_;
+	bool range_open_end_;
+	mutable MinMaxIndex min_max_index_;
 
 };
 
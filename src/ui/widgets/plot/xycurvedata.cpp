@@ -25,11 +25,14 @@
 #include <QPointF>
 #include <QRectF>
 #include <QString>
+#include <QtGlobal>
+#include <qwt_scale_map.h>
 
 #include "xycurvedata.hpp"
 #include "src/data/analogtimesignal.hpp"
 #include "src/data/datautil.hpp"
 #include "src/ui/widgets/plot/basecurvedata.hpp"
+#include "src/ui/widgets/plot/pointindex.hpp"
 
 using std::lock_guard;
 using std::make_shared;
@@ -48,10 +51,11 @@ XYCurveData::XYCurveData(shared_ptr<sv::data::AnalogTimeSignal> x_t_signal,
 	x_t_signal_(x_t_signal),
 	y_t_signal_(y_t_signal),
 	x_t_signal_pos_(0),
-	y_t_signal_pos_(0)
+	y_t_signal_pos_(0),
+	x_data_(make_shared<vector<double>>()),
+	y_data_(make_shared<vector<double>>()),
+	point_index_(x_data_, y_data_)
 {
-	x_data_ = make_shared<vector<double>>();
-	y_data_ = make_shared<vector<double>>();
 
 	// Prefill data vectors
 	this->on_sample_appended();
@@ -91,27 +95,21 @@ QRectF XYCurveData::boundingRect() const
 		QPointF(x_t_signal_->max_value(), y_t_signal_->min_value()));
 }
 
-QPointF XYCurveData::closest_point(const QPointF &pos, double *dist) const
+QPointF XYCurveData::closest_point(const QPointF &pos,
+	const QwtScaleMap &x_map, const QwtScaleMap &y_map, double *dist) const
 {
-	const size_t num_samples = size();
-	if (num_samples <= 0)
-		return QPointF(0, 0); // TODO
+	// Pixels per unit of the (linear) axes
+	double x_scale = 1.;
+	if (x_map.sDist() != 0)
+		x_scale = qAbs(x_map.pDist() / x_map.sDist());
+	double y_scale = 1.;
+	if (y_map.sDist() != 0)
+		y_scale = qAbs(y_map.pDist() / y_map.sDist());
 
-	size_t index = -1;
-	double dmin = 1.0e10;
-
-	for (size_t i=0; i < num_samples; i++) {
-		const QPointF s = sample(i);
-		const double cx = s.x() - pos.x();
-		const double cy = s.y() - pos.y();
-		const double d = qwtSqr(cx) + qwtSqr(cy);
-		if (d < dmin) {
-			index = i;
-			dmin = d;
-		}
-	}
-	if (dist)
-		*dist = qSqrt(dmin);
+	long index = point_index_.nearest(
+		pos.x(), pos.y(), x_scale, y_scale, dist);
+	if (index < 0)
+		return QPointF(0, 0); // TODO
 
 	return sample(index);
 }
@@ -198,6 +196,7 @@ void XYCurveData::on_sample_appended()
 		x_t_signal_, x_t_signal_pos_,
 		y_t_signal_, y_t_signal_pos_,
 		time, x_data_, y_data_);
+	point_index_.update();
 }
 
 } // namespace plot
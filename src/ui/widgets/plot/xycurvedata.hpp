@@ -31,6 +31,7 @@
 
 #include "src/data/datautil.hpp"
 #include "src/ui/widgets/plot/basecurvedata.hpp"
+#include "src/ui/widgets/plot/pointindex.hpp"
 
 using std::mutex;
 using std::set;
@@ -65,7 +66,9 @@ public:
 	size_t size() const override;
 	QRectF boundingRect() const override;
 
-	QPointF closest_point(const QPointF &pos, double *dist) const override;
+	QPointF closest_point(const QPointF &pos,
+		const QwtScaleMap &x_map, const QwtScaleMap &y_map,
+		double *dist) const override;
 	QString name() const override;
 	sv::data::Quantity x_quantity() const override;
 	set<sv::data::QuantityFlag> x_quantity_flags() const override;
@@ -89,6 +92,7 @@ private:
 	// TODO: use some sort of AnalogSignal instead of 2 vectors?
 	shared_ptr<vector<double>> x_data_;
 	shared_ptr<vector<double>> y_data_;
+	PointIndex point_index_;
 	mutex sample_append_mutex_;
 
 private Q_SLOTS:
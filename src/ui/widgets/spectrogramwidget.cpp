@@ -0,0 +1,160 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2020 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cassert>
+#include <cmath>
+#include <vector>
+
+#include <QColor>
+#include <QPainter>
+#include <QRectF>
+#include <QSizePolicy>
+
+#include "spectrogramwidget.hpp"
+
+using std::vector;
+
+namespace sv {
+namespace ui {
+namespace widgets {
+
+SpectrogramWidget::SpectrogramWidget(int history_size, QWidget *parent) :
+	QWidget(parent),
+	history_size_(history_size),
+	newest_row_(0),
+	lower_level_(-120.),
+	upper_level_(0.)
+{
+	assert(history_size_ > 0);
+
+	init_color_table();
+
+	this->setMinimumSize(200, 150);
+	this->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Expanding);
+	// The whole widget is painted with the image, no background needed.
+	this->setAttribute(Qt::WA_OpaquePaintEvent, true);
+}
+
+void SpectrogramWidget::init_color_table()
+{
+	// Black -> blue -> magenta -> red -> yellow -> white
+	const vector<QColor> stops = {
+		QColor(0, 0, 0), QColor(0, 0, 160), QColor(160, 0, 160),
+		QColor(230, 0, 0), QColor(255, 220, 0), QColor(255, 255, 255) };
+
+	const int size = 256;
+	color_table_.resize(size);
+	for (int i=0; i<size; ++i) {
+		double pos = (double)i / (size - 1) * (stops.size() - 1);
+		size_t stop = (size_t)pos;
+		if (stop >= stops.size() - 1)
+			stop = stops.size() - 2;
+		double f = pos - stop;
+		const QColor &c1 = stops[stop];
+		const QColor &c2 = stops[stop + 1];
+		color_table_[i] = qRgb(
+			(int)(c1.red() + f * (c2.red() - c1.red())),
+			(int)(c1.green() + f * (c2.green() - c1.green())),
+			(int)(c1.blue() + f * (c2.blue() - c1.blue())));
+	}
+}
+
+void SpectrogramWidget::add_spectrum(const vector<double> &amplitudes)
+{
+	if (amplitudes.empty())
+		return;
+
+	const int bin_count = (int)amplitudes.size();
+	if (image_.isNull() || image_.width() != bin_count) {
+		image_ = QImage(bin_count, history_size_, QImage::Format_RGB32);
+		image_.fill(color_table_[0]);
+		newest_row_ = 0;
+	}
+
+	// The ring buffer is filled from the bottom to the top, so the rows from
+	// the newest to the oldest spectrum are in ascending order (with one
+	// wrap around) and can be drawn in two blocks.
+	newest_row_ = newest_row_ == 0 ? history_size_ - 1 : newest_row_ - 1;
+
+	const int max_index = (int)color_table_.size() - 1;
+	const double scale = max_index / (upper_level_ - lower_level_);
+	QRgb *line = (QRgb *)image_.scanLine(newest_row_);
+	for (int i=0; i<bin_count; ++i) {
+		int index = 0;
+		if (amplitudes[i] > 0) {
+			double level = 20 * log10(amplitudes[i]);
+			index = (int)((level - lower_level_) * scale);
+			if (index < 0)
+				index = 0;
+			else if (index > max_index)
+				index = max_index;
+		}
+		line[i] = color_table_[index];
+	}
+
+	update();
+}
+
+void SpectrogramWidget::clear()
+{
+	if (!image_.isNull())
+		image_.fill(color_table_[0]);
+	newest_row_ = 0;
+	update();
+}
+
+void SpectrogramWidget::set_level_range(double lower_level, double upper_level)
+{
+	if (upper_level <= lower_level)
+		return;
+
+	// Only new spectra are mapped with the new range, the image isn't
+	// regenerated.
+	lower_level_ = lower_level;
+	upper_level_ = upper_level;
+}
+
+void SpectrogramWidget::paintEvent(QPaintEvent *event)
+{
+	(void)event;
+
+	QPainter painter(this);
+	if (image_.isNull()) {
+		painter.fillRect(rect(), QColor(color_table_[0]));
+		return;
+	}
+
+	// Newest spectrum on top: first the rows from newest_row_ to the end of
+	// the image, then the (older) rows from the start of the image.
+	const double row_height = (double)height() / history_size_;
+	const int top_rows = history_size_ - newest_row_;
+	const QRectF top_target(0, 0, width(), top_rows * row_height);
+	painter.drawImage(top_target, image_,
+		QRectF(0, newest_row_, image_.width(), top_rows));
+	if (newest_row_ > 0) {
+		const QRectF bottom_target(0, top_target.bottom(),
+			width(), newest_row_ * row_height);
+		painter.drawImage(bottom_target, image_,
+			QRectF(0, 0, image_.width(), newest_row_));
+	}
+}
+
+} // namespace widgets
+} // namespace ui
+} // namespace sv
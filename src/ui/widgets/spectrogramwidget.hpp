@@ -0,0 +1,88 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2020 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UI_WIDGETS_SPECTROGRAMWIDGET_HPP
+#define UI_WIDGETS_SPECTROGRAMWIDGET_HPP
+
+#include <vector>
+
+#include <QImage>
+#include <QPaintEvent>
+#include <QRgb>
+#include <QWidget>
+
+using std::vector;
+
+namespace sv {
+namespace ui {
+namespace widgets {
+
+/**
+ * Waterfall display of amplitude spectra. The newest spectrum is shown at
+ * the top, older spectra move down.
+ *
+ * The spectra are stored in an image, that is used as a ring buffer: every
+ * new spectrum only overwrites the oldest row, the image is never
+ * regenerated. The amplitudes are mapped to colors via a precomputed color
+ * table.
+ */
+class SpectrogramWidget : public QWidget
+{
+	Q_OBJECT
+
+public:
+	explicit SpectrogramWidget(int history_size, QWidget *parent = nullptr);
+
+	/**
+	 * Add a new spectrum (amplitudes of the bins) as the newest row.
+	 */
+	void add_spectrum(const vector<double> &amplitudes);
+	/**
+	 * Remove all spectra.
+	 */
+	void clear();
+	/**
+	 * Set the level range in dB, that is mapped to the color table.
+	 */
+	void set_level_range(double lower_level, double upper_level);
+	double lower_level() const { return lower_level_; }
+	double upper_level() const { return upper_level_; }
+	int history_size() const { return history_size_; }
+
+protected:
+	void paintEvent(QPaintEvent *event) override;
+
+private:
+	void init_color_table();
+
+	const int history_size_;
+	/** Ring buffer of the spectra, newest_row_ is the newest spectrum. */
+	QImage image_;
+	int newest_row_;
+	double lower_level_;
+	double upper_level_;
+	vector<QRgb> color_table_;
+
+};
+
+} // namespace widgets
+} // namespace ui
+} // namespace sv
+
+#endif // UI_WIDGETS_SPECTROGRAMWIDGET_HPP